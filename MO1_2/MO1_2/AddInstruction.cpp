@@ -1,4 +1,5 @@
 ﻿#include "AddInstruction.h"
+#include "Checkpoint.h"
 #include "process.h"
 #include "utils.h"
 #include <sstream>
@@ -33,3 +34,15 @@ void AddInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
     proc->logs.push_back(logEntry.str());
     logToFile(proc->name, logEntry.str(), coreId);
 }
+
+void AddInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::ADD));
+    out.putString(resultVar);
+    out.putString(arg1);
+    out.putString(arg2);
+    out.putString(logPrefix);
+}
+
+Opcode AddInstruction::opcode() const {
+    return Opcode::ADD;
+}
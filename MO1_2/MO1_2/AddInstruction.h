@@ -1,5 +1,5 @@
 #pragma once
-#include "instruction.h"
+#include "Instruction.h"
 #include <string>
 #include <memory>
 
@@ -14,4 +14,6 @@ public:
 
     AddInstruction(const std::string& result, const std::string& lhs, const std::string& rhs, const std::string& logPrefix = "");
     void execute(std::shared_ptr<Process> proc, int coreId) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
 };
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "Affinity.h"
+#include "config.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // CPUs this process may run on (respects taskset/cgroup limits)
+    std::vector<int> allowedCpus() {
+        std::vector<int> cpus;
+#ifdef _WIN32
+        DWORD_PTR processMask = 0, systemMask = 0;
+        if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+            for (int cpu = 0; cpu < static_cast<int>(sizeof(DWORD_PTR) * 8); ++cpu) {
+                if (processMask & (static_cast<DWORD_PTR>(1) << cpu)) cpus.push_back(cpu);
+            }
+        }
+#else
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+            }
+        }
+#endif
+        if (cpus.empty()) {
+            unsigned int count = std::max(std::thread::hardware_concurrency(), 1u);
+            for (unsigned int cpu = 0; cpu < count; ++cpu) cpus.push_back(static_cast<int>(cpu));
+        }
+        return cpus;
+    }
+
+    int readTopology(int cpu, const char* field) {
+        std::ifstream in("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + field);
+        int value = -1;
+        if (!(in >> value)) return -1;
+        return value;
+    }
+
+    // Groups CPUs by (package, core) and takes the n-th thread of every physical core
+    // before any (n+1)-th, so SMT siblings are only shared once every core has one worker.
+    // Without sysfs topology (Windows, or a restricted container) the order is unchanged.
+    std::vector<int> spreadOrder(const std::vector<int>& cpus) {
+        std::map<std::pair<int, int>, std::vector<int>> cores;  // (package, core) -> threads
+        for (int cpu : cpus) {
+            int package = readTopology(cpu, "physical_package_id");
+            int core = readTopology(cpu, "core_id");
+            if (package < 0 || core < 0) return cpus;
+            cores[{ package, core }].push_back(cpu);
+        }
+
+        std::vector<int> order;
+        for (size_t thread = 0; order.size() < cpus.size(); ++thread) {
+            for (const auto& entry : cores) {
+                if (thread < entry.second.size()) order.push_back(entry.second[thread]);
+            }
+        }
+        return order;
+    }
+}
+
+int AffinityPlan::cpuForCore(int coreId) const {
+    if (!enabled || order.empty()) return -1;
+    return order[coreId % order.size()];
+}
+
+void AffinityPlan::describe(std::ostream& out, int cores) const {
+    if (!enabled) return;
+    out << "CPU affinity:";
+    for (int i = 0; i < cores; ++i) out << " core " << i << "->cpu " << cpuForCore(i) << (i + 1 < cores ? "," : "");
+    out << "; tick->cpu " << tickCpu << "\n";
+    if (cores > static_cast<int>(order.size())) {
+        out << "  (" << cores << " cores share " << order.size() << " host CPUs)\n";
+    }
+}
+
+bool planAffinity(const Config& config, AffinityPlan& plan) {
+    plan = AffinityPlan();
+    if (config.affinity == "none" || config.affinity.empty()) return true;
+
+    std::vector<int> allowed = allowedCpus();
+    if (config.affinity == "auto") {
+        plan.order = spreadOrder(allowed);
+    }
+    else if (config.affinity == "manual") {
+        std::istringstream list(config.affinityCpus);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            if (item.empty()) continue;
+            int cpu = -1;
+            try { cpu = std::stoi(item); }
+            catch (...) {}
+            if (std::find(allowed.begin(), allowed.end(), cpu) == allowed.end()) {
+                std::cout << "affinity-cpus: CPU " << item << " is not available to this process.\n";
+                return false;
+            }
+            plan.order.push_back(cpu);
+        }
+        if (plan.order.empty()) {
+            std::cout << "affinity manual needs affinity-cpus, e.g. affinity-cpus 0,2,4,6\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Unknown affinity mode: " << config.affinity << " (expected none, auto or manual)\n";
+        return false;
+    }
+
+    plan.enabled = true;
+    plan.tickCpu = config.affinityTickCpu >= 0 ? config.affinityTickCpu : plan.order.back();
+    return true;
+}
+
+bool pinThread(std::thread& thread, int cpu) {
+    if (cpu < 0 || !thread.joinable()) return false;
+#ifdef _WIN32
+    if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) return false;
+    return SetThreadAffinityMask(thread.native_handle(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#else
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#endif
+}
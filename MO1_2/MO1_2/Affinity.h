@@ -0,0 +1,28 @@
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <ostream>
+
+class Config;
+
+// Which host CPU each emulated core (and the tick thread) is pinned to
+struct AffinityPlan {
+    bool enabled = false;
+    std::vector<int> order;   // host CPUs in placement order; core i uses order[i % size]
+    int tickCpu = -1;
+
+    int cpuForCore(int coreId) const;
+    void describe(std::ostream& out, int cores) const;
+};
+
+// Builds the plan from the affinity keys. Returns false (with a message) for a bad
+// manual list; "auto" walks the physical cores of each package before any SMT sibling.
+bool planAffinity(const Config& config, AffinityPlan& plan);
+
+// Pins a running std::thread to one host CPU; a no-op on platforms without support
+bool pinThread(std::thread& thread, int cpu);
+
+#endif // AFFINITY_H
@@ -0,0 +1,449 @@
+#include "Benchmark.h"
+#include "scheduler.h"
+#include "MemoryManager.h"
+#include "ProcessManager.h"
+#include "DeclareInstruction.h"
+#include "AddInstruction.h"
+#include "SubtractInstruction.h"
+#include "PrintInstruction.h"
+#include "SleepInstruction.h"
+#include "ForInstruction.h"
+#include "utils.h"
+#include "config.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cstdio>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct BenchResult {
+        std::string name;
+        size_t ops = 0;
+        double meanNs = 0;
+        double p50 = 0;
+        double p90 = 0;
+        double p99 = 0;
+        double max = 0;
+    };
+
+    double elapsedNs(Clock::time_point start, Clock::time_point end) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    BenchResult summarize(const std::string& name, std::vector<double>& samples) {
+        BenchResult result;
+        result.name = name;
+        result.ops = samples.size();
+        if (samples.empty()) return result;
+
+        std::sort(samples.begin(), samples.end());
+        auto at = [&samples](double pct) {
+            size_t idx = static_cast<size_t>(pct / 100.0 * (samples.size() - 1));
+            return samples[idx];
+        };
+        result.meanNs = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+        result.p50 = at(50);
+        result.p90 = at(90);
+        result.p99 = at(99);
+        result.max = samples.back();
+        return result;
+    }
+
+    template <typename Fn>
+    BenchResult timeEach(const std::string& name, int iterations, Fn&& fn) {
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            auto start = Clock::now();
+            fn(i);
+            samples.push_back(elapsedNs(start, Clock::now()));
+        }
+        return summarize(name, samples);
+    }
+
+    void printHeader(const std::string& section) {
+        std::cout << "\n== " << section << " ==\n";
+        std::cout << std::left << std::setw(44) << "benchmark" << std::right
+            << std::setw(9) << "ops" << std::setw(12) << "ns/op" << std::setw(11) << "p50"
+            << std::setw(11) << "p90" << std::setw(11) << "p99" << std::setw(12) << "max" << "\n";
+    }
+
+    void printResult(const BenchResult& r) {
+        std::cout << std::left << std::setw(44) << r.name << std::right << std::fixed << std::setprecision(0)
+            << std::setw(9) << r.ops << std::setw(12) << r.meanNs << std::setw(11) << r.p50
+            << std::setw(11) << r.p90 << std::setw(11) << r.p99 << std::setw(12) << r.max << "\n";
+    }
+
+    std::shared_ptr<Process> makeBenchProcess(int pid, size_t memory) {
+        auto proc = std::make_shared<Process>();
+        proc->pid = pid;
+        proc->name = "bench_" + std::to_string(pid);
+        proc->setRequiredMemory(memory);
+        return proc;
+    }
+
+    void benchMemory() {
+        printHeader("MemoryManager allocate/deallocate");
+        MemoryManager& mm = MemoryManager::getInstance();
+        const size_t total = mm.getTotalMemory();
+
+        // Steady state: one block handed out and returned over and over
+        {
+            mm.reset();
+            auto proc = makeBenchProcess(1, 1024);
+            std::vector<double> allocSamples, freeSamples;
+            for (int i = 0; i < 20000; ++i) {
+                auto t0 = Clock::now();
+                mm.allocate(proc);
+                auto t1 = Clock::now();
+                mm.deallocate(proc);
+                auto t2 = Clock::now();
+                allocSamples.push_back(elapsedNs(t0, t1));
+                freeSamples.push_back(elapsedNs(t1, t2));
+                proc->setBaseAddress(-1);
+            }
+            printResult(summarize("allocate 1KB, empty memory", allocSamples));
+            printResult(summarize("deallocate 1KB, empty memory", freeSamples));
+        }
+
+        // Fragmented: memory full of 64B blocks with every other one freed, leaving
+        // only the tail large enough, so first fit walks the whole block list
+        {
+            mm.reset();
+            const size_t small = 64, tail = 1024;
+            std::vector<std::shared_ptr<Process>> residents;
+            for (size_t used = 0; used + small <= total - tail; used += small) {
+                auto proc = makeBenchProcess(static_cast<int>(residents.size()) + 10, small);
+                mm.allocate(proc);
+                residents.push_back(proc);
+            }
+            for (size_t i = 0; i < residents.size(); i += 2) mm.deallocate(residents[i]);
+
+            auto proc = makeBenchProcess(2, 512);
+            std::vector<double> allocSamples, freeSamples;
+            for (int i = 0; i < 5000; ++i) {
+                auto t0 = Clock::now();
+                mm.allocate(proc);
+                auto t1 = Clock::now();
+                mm.deallocate(proc);
+                auto t2 = Clock::now();
+                allocSamples.push_back(elapsedNs(t0, t1));
+                freeSamples.push_back(elapsedNs(t1, t2));
+                proc->setBaseAddress(-1);
+            }
+            printResult(summarize("allocate 512B, " + std::to_string(residents.size()) + " blocks fragmented", allocSamples));
+            printResult(summarize("deallocate 512B, fragmented", freeSamples));
+
+            auto tooBig = makeBenchProcess(3, tail * 2);
+            printResult(timeEach("failed allocate, fragmented", 5000, [&](int) { mm.allocate(tooBig); }));
+        }
+
+        // Churn: random sizes, evicting a random resident whenever allocation fails
+        {
+            mm.reset();
+            std::mt19937 gen(12345);
+            std::uniform_int_distribution<size_t> sizeDist(64, 2048);
+            std::vector<std::shared_ptr<Process>> live;
+            std::vector<double> allocSamples, freeSamples;
+            for (int i = 0; i < 20000; ++i) {
+                auto proc = makeBenchProcess(100 + i, sizeDist(gen));
+                while (true) {
+                    auto t0 = Clock::now();
+                    bool ok = mm.allocate(proc);
+                    allocSamples.push_back(elapsedNs(t0, Clock::now()));
+                    if (ok || live.empty()) break;
+
+                    size_t victim = std::uniform_int_distribution<size_t>(0, live.size() - 1)(gen);
+                    auto t1 = Clock::now();
+                    mm.deallocate(live[victim]);
+                    freeSamples.push_back(elapsedNs(t1, Clock::now()));
+                    live[victim] = live.back();
+                    live.pop_back();
+                }
+                if (proc->getBaseAddress() != -1) live.push_back(proc);
+            }
+            printResult(summarize("allocate random 64B-2KB, churn", allocSamples));
+            printResult(summarize("deallocate random 64B-2KB, churn", freeSamples));
+        }
+
+        mm.reset();
+    }
+
+    // Every thread allocates and frees its own 512B block as core t, first with one shared
+    // arena, then with one arena per thread (ns/op = wall time per allocate+free pair)
+    void benchMemoryParallel() {
+        printHeader("MemoryManager parallel allocate/deallocate (ns/op = wall time per pair, percentiles = allocate)");
+        Config& config = Config::getInstance();
+        const int savedCPU = config.numCPU, savedArenas = config.memoryArenas;
+        const size_t savedMem = config.memPerProc, savedMaxMem = config.maxMemPerProc;
+        config.memPerProc = 512;
+        config.maxMemPerProc = 0;
+        MemoryManager& mm = MemoryManager::getInstance();
+        const int perThread = 20000;
+
+        for (int arenas : { 1, 0 }) {
+            for (int threads : { 1, 2, 4, 8 }) {
+                config.numCPU = threads;
+                config.memoryArenas = arenas;
+                mm.reset();
+
+                std::vector<std::vector<double>> samples(threads);
+                std::vector<std::thread> workers;
+                auto start = Clock::now();
+                for (int c = 0; c < threads; ++c) {
+                    workers.emplace_back([&mm, &samples, c, perThread]() {
+                        auto proc = makeBenchProcess(1000 + c, 512);
+                        samples[c].reserve(perThread);
+                        for (int i = 0; i < perThread; ++i) {
+                            auto t0 = Clock::now();
+                            mm.allocate(proc, c);
+                            samples[c].push_back(elapsedNs(t0, Clock::now()));
+                            mm.deallocate(proc, c);
+                            proc->setBaseAddress(-1);
+                        }
+                        });
+                }
+                for (auto& t : workers) t.join();
+                double wallNs = elapsedNs(start, Clock::now());
+
+                std::vector<double> all;
+                for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+                BenchResult r = summarize(std::to_string(threads) + " threads, " + (arenas == 1 ? "1 arena" : "per-core arenas"), all);
+                r.meanNs = wallNs / (static_cast<double>(perThread) * threads);
+                printResult(r);
+            }
+        }
+
+        config.numCPU = savedCPU;
+        config.memoryArenas = savedArenas;
+        config.memPerProc = savedMem;
+        config.maxMemPerProc = savedMaxMem;
+        mm.reset();
+    }
+
+    void benchReadyQueue() {
+        printHeader("ProcessScheduler enqueue/dequeue (ns/op = wall time per item, percentiles = dequeue wait)");
+        const int totalItems = 40000;
+
+        for (int threads : { 1, 2, 4, 8 }) {
+            ProcessScheduler scheduler;
+            // Never started, so consumers past the default core count would count as retired cores
+            scheduler.setCoreCount(threads);
+            std::vector<std::shared_ptr<Process>> pool;
+            pool.reserve(totalItems);
+            for (int i = 0; i < totalItems; ++i) pool.push_back(makeBenchProcess(i, 0));
+
+            const int perThread = totalItems / threads;
+            std::vector<std::vector<double>> waits(threads);
+            std::vector<std::thread> workers;
+
+            auto start = Clock::now();
+            for (int c = 0; c < threads; ++c) {
+                workers.emplace_back([&scheduler, &waits, c, perThread]() {
+                    waits[c].reserve(perThread);
+                    for (int i = 0; i < perThread; ++i) {
+                        auto t0 = Clock::now();
+                        scheduler.takeNext(c);
+                        waits[c].push_back(elapsedNs(t0, Clock::now()));
+                    }
+                    });
+            }
+            for (int p = 0; p < threads; ++p) {
+                workers.emplace_back([&scheduler, &pool, p, perThread]() {
+                    for (int i = 0; i < perThread; ++i) scheduler.addProcess(pool[p * perThread + i]);
+                    });
+            }
+            for (auto& t : workers) t.join();
+            double wallNs = elapsedNs(start, Clock::now());
+
+            std::vector<double> all;
+            for (auto& w : waits) all.insert(all.end(), w.begin(), w.end());
+            BenchResult r = summarize(std::to_string(threads) + " producers / " + std::to_string(threads) + " consumers", all);
+            r.meanNs = wallNs / (perThread * threads);
+            printResult(r);
+        }
+    }
+
+    void benchInstructions() {
+        printHeader("Instruction execution (includes per-instruction log file write)");
+        auto proc = makeBenchProcess(1, 0);
+        proc->name = "bench_opcodes";
+        proc->memory["x"] = 1;
+
+        std::vector<std::pair<std::string, std::shared_ptr<Instruction>>> opcodes = {
+            { "DECLARE", std::make_shared<DeclareInstruction>("y", 5) },
+            { "ADD", std::make_shared<AddInstruction>("x", "x", "1") },
+            { "SUBTRACT", std::make_shared<SubtractInstruction>("x", "x", "1") },
+            { "PRINT", std::make_shared<PrintInstruction>("Value: ", "x", true) },
+            { "SLEEP", std::make_shared<SleepInstruction>(10) },
+            { "FOR (3 x PRINT)", std::make_shared<ForInstruction>(3,
+                std::vector<std::shared_ptr<Instruction>>{ std::make_shared<PrintInstruction>("loop") }) }
+        };
+
+        for (const auto& op : opcodes) {
+            printResult(timeEach(op.first, 2000, [&](int) { op.second->execute(proc, 0); }));
+            proc->logs.clear();
+        }
+        std::remove("bench_opcodes.txt");
+    }
+
+    void benchProcessCreation() {
+        printHeader("ProcessManager::createProcess");
+        const auto& config = Config::getInstance();
+        std::string label = "createProcess " + std::to_string(config.minInstructions) + "-" +
+            std::to_string(config.maxInstructions) + " instructions";
+        printResult(timeEach(label, 2000, [&](int i) {
+            ProcessManager::createProcess("bench", i, config.minInstructions, config.maxInstructions,
+                config.memPerProc, static_cast<unsigned int>(i + 1));
+            }));
+    }
+
+    void benchLogging() {
+        printHeader("Logging");
+        auto proc = makeBenchProcess(1, 0);
+        proc->name = "bench_log";
+        printResult(timeEach("Process::log (in-memory)", 20000, [&](int) { proc->log("benchmark log line"); }));
+        printResult(timeEach("logToFile (append + reopen)", 5000, [](int) { logToFile("bench_log", "benchmark log line", 0); }));
+        printResult(timeEach("getCurrentTimestamp", 20000, [](int) { getCurrentTimestamp(); }));
+        std::remove("bench_log.txt");
+    }
+
+    // Integer value following "--name" on the command line, or fallback if absent
+    long long optionValue(int argc, char* argv[], const std::string& name, long long fallback) {
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (name == argv[i]) {
+                try { return std::stoll(argv[i + 1]); }
+                catch (...) { return fallback; }
+            }
+        }
+        return fallback;
+    }
+
+    struct ScalingPoint {
+        int cores = 0;
+        double seconds = 0;
+        uint64_t instructions = 0;
+        double avgTurnaround = 0;
+        uint64_t allocAttempts = 0;
+        uint64_t allocFailures = 0;
+    };
+
+    ScalingPoint runScalingPoint(int cores, int processCount, int minIns, int maxIns, size_t memPerProc, unsigned int seed) {
+        Config& config = Config::getInstance();
+        MemoryManager& mm = MemoryManager::getInstance();
+        // reset() sizes the arenas from these, so they must describe this point before it runs
+        config.numCPU = cores;
+        config.memPerProc = memPerProc;
+        config.maxMemPerProc = 0;
+        mm.reset();
+
+        // Same seeds at every point, so each core count runs the identical workload
+        std::vector<std::shared_ptr<Process>> workload;
+        for (int pid = 1; pid <= processCount; ++pid) {
+            workload.push_back(ProcessManager::createProcess("bench_p" + std::to_string(pid), pid,
+                minIns, maxIns, memPerProc, seed + pid));
+        }
+
+        ScalingPoint point;
+        point.cores = cores;
+        uint64_t allocBase = mm.getAllocations();
+        uint64_t failBase = mm.getAllocationFailures();
+
+        ProcessScheduler scheduler;
+        scheduler.setQuiet(true);
+        scheduler.start(config);
+
+        auto start = Clock::now();
+        for (auto& proc : workload) scheduler.addProcess(proc);
+        while (scheduler.getProcessesFinished() < static_cast<uint64_t>(processCount)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        point.seconds = elapsedNs(start, Clock::now()) / 1e9;
+        point.instructions = scheduler.totalInstructions();
+        scheduler.shutdown();
+
+        uint64_t allocations = mm.getAllocations() - allocBase;
+        point.allocFailures = mm.getAllocationFailures() - failBase;
+        point.allocAttempts = allocations + point.allocFailures;
+
+        double turnaround = 0;
+        for (auto& proc : workload) {
+            turnaround += proc->completionTick - proc->arrivalTick;
+            std::remove((proc->name + ".txt").c_str());
+            std::remove((proc->name + "_log.txt").c_str());
+        }
+        point.avgTurnaround = turnaround / processCount;
+        return point;
+    }
+}
+
+int runMicroBenchmarks() {
+    std::cout << "CSOPESY microbenchmarks (all times in nanoseconds)\n";
+    benchMemory();
+    benchMemoryParallel();
+    benchReadyQueue();
+    benchInstructions();
+    benchProcessCreation();
+    benchLogging();
+    std::cout << "\n";
+    return 0;
+}
+
+int runScalingBenchmark(int argc, char* argv[]) {
+    Config& config = Config::getInstance();
+    const int processCount = static_cast<int>(optionValue(argc, argv, "--processes", 64));
+    const int minIns = static_cast<int>(optionValue(argc, argv, "--min-ins", config.minInstructions));
+    const int maxIns = static_cast<int>(optionValue(argc, argv, "--max-ins", config.maxInstructions));
+    const size_t memPerProc = static_cast<size_t>(optionValue(argc, argv, "--mem-per-proc", static_cast<long long>(config.memPerProc)));
+    const int maxCores = static_cast<int>(optionValue(argc, argv, "--max-cpu", 128));
+    const unsigned int seed = config.seed != 0 ? config.seed : 1;
+
+    if (processCount <= 0 || minIns <= 0 || maxIns < minIns || maxCores <= 0) {
+        std::cout << "Invalid benchmark options.\n";
+        return 1;
+    }
+
+    const int savedCPU = config.numCPU;
+    const size_t savedMem = config.memPerProc;
+    const size_t savedMaxMem = config.maxMemPerProc;
+    std::cout << "CSOPESY core-scaling benchmark\n";
+    std::cout << processCount << " processes, " << minIns << "-" << maxIns << " instructions, "
+        << memPerProc << " bytes each, scheduler " << config.scheduler << ", quantum " << config.quantumCycles
+        << ", delay " << config.delayPerInstruction << "ms, seed " << seed << "\n\n";
+    std::cout << std::right << std::setw(6) << "cores" << std::setw(11) << "wall s" << std::setw(14) << "instr/s"
+        << std::setw(10) << "speedup" << std::setw(17) << "avg turnaround" << std::setw(13) << "alloc tries"
+        << std::setw(12) << "alloc fail" << "\n";
+
+    double baseline = 0;
+    for (int cores = 1; cores <= maxCores; cores *= 2) {
+        ScalingPoint point = runScalingPoint(cores, processCount, minIns, maxIns, memPerProc, seed);
+        double rate = point.seconds > 0 ? point.instructions / point.seconds : 0;
+        if (baseline == 0) baseline = rate;
+        double failRate = point.allocAttempts == 0 ? 0.0
+            : (static_cast<double>(point.allocFailures) / point.allocAttempts) * 100.0;
+
+        std::cout << std::fixed << std::setw(6) << point.cores
+            << std::setw(11) << std::setprecision(2) << point.seconds
+            << std::setw(14) << std::setprecision(0) << rate
+            << std::setw(9) << std::setprecision(2) << (baseline > 0 ? rate / baseline : 0) << "x"
+            << std::setw(11) << std::setprecision(1) << point.avgTurnaround << " ticks"
+            << std::setw(13) << point.allocAttempts
+            << std::setw(11) << std::setprecision(1) << failRate << "%\n";
+        std::cout.flush();
+    }
+
+    config.numCPU = savedCPU;
+    config.memPerProc = savedMem;
+    config.maxMemPerProc = savedMaxMem;
+    MemoryManager::getInstance().reset();
+    std::cout << "\n";
+    return 0;
+}
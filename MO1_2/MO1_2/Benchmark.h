@@ -0,0 +1,16 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// Headless benchmark modes, selected with --bench <mode> on the command line.
+// Each returns the process exit code.
+
+// Microbenchmarks of the emulator's core data paths: allocator, ready queue,
+// instruction execution, process creation and logging. Reports ns/op and percentiles.
+int runMicroBenchmarks();
+
+// Runs one seeded workload to completion at num-cpu 1, 2, 4, ... up to --max-cpu (default 128)
+// and reports instructions/second, average turnaround and allocation failure rate per point.
+// Options: --processes, --min-ins, --max-ins, --mem-per-proc; everything else comes from config.txt.
+int runScalingBenchmark(int argc, char* argv[]);
+
+#endif // BENCHMARK_H
@@ -2,12 +2,20 @@
 #include "scheduler.h"
 #include "ProcessManager.h"
 #include "config.h"
+#include "TraceRecorder.h"
+#include "LatencyStats.h"
+#include "Profiler.h"
+#include "ProgramCache.h"
+#include "MetricsExporter.h"
+#include "ConsoleView.h"
 #include <iostream>
+#include <fstream>
 #include <thread>
 #include <chrono>
 #include <sstream>
+#include <iomanip>
 
-CLIManager::CLIManager() : generating(false) {}
+CLIManager::CLIManager() : generating(false), headless(false), exitRequested(false) {}
 
 void CLIManager::run() {
     std::string input;
@@ -21,6 +29,72 @@ void CLIManager::run() {
     }
 }
 
+int CLIManager::runScript(const std::string& scriptPath, int runForTicks, const std::string& summaryPath) {
+    headless = true;
+    setSchedulerQuiet(true);
+
+    if (!scriptPath.empty()) {
+        std::ifstream script(scriptPath);
+        if (!script.is_open()) {
+            std::cout << "Could not open script: " << scriptPath << "\n";
+            return 1;
+        }
+
+        std::string line;
+        while (!exitRequested && std::getline(script, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            size_t first = line.find_first_not_of(" \t");
+            if (first == std::string::npos || line[first] == '#') continue;
+            handleCommand(line.substr(first));
+        }
+    }
+    else if (!isSchedulerRunning()) {
+        handleCommand("scheduler-start");
+    }
+
+    if (!exitRequested && runForTicks > 0) waitTicks(runForTicks);
+    shutdown();
+
+    std::ofstream summary(summaryPath);
+    if (!summary.is_open()) {
+        std::cout << "Could not write summary to " << summaryPath << "\n";
+        return 1;
+    }
+    writeSummary(summary);
+    std::cout << "Summary written to " << summaryPath << "\n";
+    return 0;
+}
+
+bool CLIManager::restore(const std::string& checkpointPath) {
+    bool resumeGenerating = false;
+    if (!restoreCheckpoint(checkpointPath, resumeGenerating)) return false;
+    if (resumeGenerating && workload.configure(Config::getInstance())) {
+        generating = true;
+        workload.start();
+    }
+    return true;
+}
+
+// Blocks until the scheduler clock has advanced by the given number of ticks
+void CLIManager::waitTicks(int ticks) const {
+    if (!isSchedulerRunning()) {
+        std::cout << "Scheduler is not running; nothing to wait for.\n";
+        return;
+    }
+    int target = cpuTick.load() + ticks;
+    while (cpuTick.load() < target && isSchedulerRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+// Stops process generation and the cores without waiting for the queue to drain
+void CLIManager::shutdown() {
+    generating = false;
+    workload.stop();
+    shutdownScheduler();
+    MetricsExporter::getInstance().stop();
+}
+
 void CLIManager::handleCommand(const std::string& input) {
     auto tokens = tokenize(input);
     if (tokens.empty()) return;
@@ -34,22 +108,10 @@ void CLIManager::handleCommand(const std::string& input) {
         }
 
         const auto& config = Config::getInstance();
-        startScheduler(config);
+        if (!workload.configure(config)) return;
+        if (!isSchedulerRunning()) startScheduler(config);
         generating = true;
-
-        // Start generator thread
-        schedulerThread = std::thread([this]() {
-            const auto& config = Config::getInstance();
-            while (generating) {
-                auto proc = ProcessManager::createUniqueNamedProcess(config.minInstructions, config.maxInstructions, config.memPerProc);
-                ProcessManager::addProcess(proc);
-                addProcess(proc); // Add to scheduler queue
-                /*std::cout << "[INFO] Created process: " << proc->name
-                    << " (PID: " << proc->pid << ", Total Instructions: "
-                    << proc->totalInstructions << ")\n";*/
-                std::this_thread::sleep_for(std::chrono::seconds(config.batchProcessFreq));
-            }
-            });
+        workload.start();
 
         std::cout << "Scheduler started. Generating processes...\n";
     }
@@ -60,17 +122,159 @@ void CLIManager::handleCommand(const std::string& input) {
         }
 
         generating = false;
-        if (schedulerThread.joinable()) schedulerThread.join();
+        workload.stop();
         stopScheduler(); // graceful shutdown
         std::cout << "Scheduler stopped.\n";
     }
     else if (cmd == "screen" && tokens.size() > 1 && tokens[1] == "-ls") {
         showProcessList();
     }
+    else if (cmd == "screen" && tokens.size() > 2 && tokens[1] == "-s") {
+        if (ProcessManager::findByName(tokens[2])) {
+            std::cout << "Process " << tokens[2] << " already exists.\n";
+            return;
+        }
+        std::shared_ptr<Process> proc;
+        if (tokens.size() > 3) {
+            std::string error;
+            auto program = ProgramCache::getInstance().load(tokens[3], error);
+            if (!program) {
+                std::cout << "Cannot load program " << tokens[3] << ": " << error << "\n";
+                return;
+            }
+            proc = ProcessManager::createNamedProcess(tokens[2], program);
+        }
+        else proc = ProcessManager::createNamedProcess(tokens[2]);
+        ProcessManager::addProcess(proc);
+        addProcess(proc);
+        if (headless) std::cout << "Created process " << proc->name << " (PID: " << proc->pid << ")\n";
+        else ConsoleView::show(proc);
+    }
+    else if (cmd == "screen" && tokens.size() > 2 && tokens[1] == "-r") {
+        auto proc = ProcessManager::findByName(tokens[2]);
+        if (!proc) {
+            std::cout << "Process " << tokens[2] << " not found.\n";
+            return;
+        }
+        if (headless) {
+            ConsoleView::displayProcessScreen(proc);
+            std::cout << "\n";
+        }
+        else ConsoleView::show(proc);
+    }
+    else if (cmd == "report-util") {
+        generateReport();
+    }
+    else if (cmd == "latency") {
+        std::cout << "\n";
+        LatencyStats::getInstance().writeReport(std::cout);
+        std::cout << "\n";
+    }
+    else if (cmd == "top") {
+        // Like top(1): counters are sampled now and again after the interval; with the
+        // scheduler stopped the totals since startup are shown instead
+        int ticks = 10;
+        if (tokens.size() > 1) {
+            try {
+                ticks = std::stoi(tokens[1]);
+            }
+            catch (const std::exception&) {
+                ticks = -1;
+            }
+            if (ticks <= 0) {
+                std::cout << "Usage: top [ticks]\n";
+                return;
+            }
+        }
+        Profiler& profiler = Profiler::getInstance();
+        ProfileSample before;
+        if (isSchedulerRunning()) {
+            before = profiler.capture();
+            waitTicks(ticks);
+        }
+        profiler.writeTop(std::cout, before, profiler.capture(), 10);
+    }
+    else if (cmd == "metrics") {
+        writeMetrics(std::cout);
+    }
+    else if (cmd == "trace-start") {
+        if (tokens.size() < 2) {
+            std::cout << "Usage: trace-start <file>\n";
+            return;
+        }
+        if (TraceRecorder::getInstance().start(tokens[1])) {
+            std::cout << "Recording scheduling trace to " << tokens[1] << "\n";
+        }
+        else {
+            std::cout << "Could not start trace (already recording or file not writable).\n";
+        }
+    }
+    else if (cmd == "trace-stop") {
+        size_t events = TraceRecorder::getInstance().stop();
+        std::cout << "Trace stopped. " << events << " events recorded.\n";
+    }
+    else if (cmd == "replay") {
+        if (tokens.size() < 2) {
+            std::cout << "Usage: replay <file>\n";
+            return;
+        }
+        if (generating) {
+            std::cout << "Stop the scheduler before replaying a trace.\n";
+            return;
+        }
+        startReplay(tokens[1]);
+    }
+    else if (cmd == "reload-config") {
+        std::string file = tokens.size() > 1 ? tokens[1] : "config.txt";
+        // Staged in a copy: cores, the generator and process logs read the live Config without a lock.
+        // It starts from the live scheduler settings so keys the file leaves out keep their values.
+        Config& live = Config::getInstance();
+        Config updated;
+        updated.copySchedulerSettings(live);
+        std::string error;
+        if (!updated.loadFromFile(file)) {
+            std::cout << "Configuration not reloaded.\n";
+            return;
+        }
+        if (!updated.validateLive(error)) {
+            std::cout << "Configuration not reloaded: " << error << ".\n";
+            return;
+        }
+        if (!isSchedulerRunning()) {
+            live.loadFromFile(file);
+            std::cout << "Configuration reloaded; it applies at the next scheduler-start.\n";
+            return;
+        }
+        // Only the scheduler's own settings change live; the rest apply after a stop and another reload.
+        // Those settings are only read by this thread (start, reconfigure, reports), so they are
+        // kept in the live Config for the next scheduler-start.
+        if (reconfigureScheduler(updated)) live.copySchedulerSettings(updated);
+    }
+    else if (cmd == "checkpoint") {
+        if (tokens.size() < 2) {
+            std::cout << "Usage: checkpoint <file>\n";
+            return;
+        }
+        writeCheckpoint(tokens[1], generating);
+    }
+    else if (cmd == "wait") {
+        if (tokens.size() < 2) {
+            std::cout << "Usage: wait <ticks>\n";
+            return;
+        }
+        try {
+            waitTicks(std::stoi(tokens[1]));
+        }
+        catch (const std::exception&) {
+            std::cout << "Invalid tick count: " << tokens[1] << "\n";
+        }
+    }
     else if (cmd == "exit") {
-        generating = false;
-        if (schedulerThread.joinable()) schedulerThread.join();
-        stopScheduler();
+        if (headless) {
+            exitRequested = true;
+            return;
+        }
+        shutdown();
         std::cout << "Exiting CLI.\n";
         exit(0);
     }
@@ -88,23 +292,36 @@ std::vector<std::string> CLIManager::tokenize(const std::string& input) const {
 }
 
 void CLIManager::showProcessList() const {
-    auto running = ProcessManager::getRunningProcesses();
-    auto waiting = ProcessManager::getWaitingProcesses();
-    auto finished = ProcessManager::getFinishedProcesses();
+    auto snapshot = takeSnapshot();
+
+    std::cout << "\nCPU utilization: " << std::fixed << std::setprecision(1) << snapshot.cpuUtilization << "% (time-averaged)\n";
+    std::cout << "Cores used: " << snapshot.coresUsed << " / " << snapshot.numCPU << "\n";
+    for (const auto& core : snapshot.cores) {
+        std::cout << "  Core " << core.coreId << ": " << core.utilization << "% busy, "
+            << (core.process ? core.process->name : "idle") << "\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
 
     std::cout << "\n=== PROCESS LIST ===\n";
     std::cout << "RUNNING:\n";
-    for (const auto& p : running) {
-        std::cout << "  " << p->name << " (PID: " << p->pid
-            << ") [" << *p->completedInstructions << "/" << p->totalInstructions << "]\n";
+    for (const auto& core : snapshot.cores) {
+        if (!core.process) continue;
+        const auto& p = core.process;
+        std::cout << "  " << p->name << " (PID: " << p->pid << ") Core " << core.coreId
+            << " [" << *p->completedInstructions << "/" << p->totalInstructions << "]\n";
     }
     std::cout << "\nWAITING:\n";
-    for (const auto& p : waiting) {
+    for (const auto& p : snapshot.waiting) {
         std::cout << "  " << p->name << " (PID: " << p->pid
             << ") [" << *p->completedInstructions << "/" << p->totalInstructions << "]\n";
     }
     std::cout << "\nFINISHED:\n";
-    for (const auto& p : finished) {
+    for (const auto& p : snapshot.archived) {
+        std::cout << "  " << p.name << " (PID: " << p.pid
+            << ") [" << p.totalInstructions << "/" << p.totalInstructions << "] (archived)\n";
+    }
+    for (const auto& p : snapshot.finished) {
         std::cout << "  " << p->name << " (PID: " << p->pid
             << ") [" << p->totalInstructions << "/" << p->totalInstructions << "]\n";
     }
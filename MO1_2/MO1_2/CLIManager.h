@@ -1,12 +1,17 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <thread>
+#include "WorkloadGenerator.h"
 
 class CLIManager {
 public:
     CLIManager();
     void run();
+    // Headless: runs the commands in scriptPath (if any), then waits runForTicks ticks,
+    // stops the scheduler and writes a JSON summary to summaryPath. Returns the exit code.
+    int runScript(const std::string& scriptPath, int runForTicks, const std::string& summaryPath);
+    // Resumes a checkpointed run; process generation restarts if it was on when the checkpoint was taken
+    bool restore(const std::string& checkpointPath);
     /*void stopScheduler();*/
     void showHelp() const;
 
@@ -14,7 +19,11 @@ private:
     void handleCommand(const std::string& input);
     std::vector<std::string> tokenize(const std::string& input) const;
     void showProcessList() const;
+    void waitTicks(int ticks) const;
+    void shutdown();
 
     bool generating;
-    std::thread schedulerThread;
+    bool headless;
+    bool exitRequested;
+    WorkloadGenerator workload;
 };
\ No newline at end of file
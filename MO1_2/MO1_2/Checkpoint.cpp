@@ -0,0 +1,351 @@
+#include "Checkpoint.h"
+#include "Instruction.h"
+#include "DeclareInstruction.h"
+#include "AddInstruction.h"
+#include "SubtractInstruction.h"
+#include "PrintInstruction.h"
+#include "SleepInstruction.h"
+#include "ForInstruction.h"
+#include "ReadInstruction.h"
+#include "WriteInstruction.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char CHECKPOINT_MAGIC[4] = { 'C', 'S', 'C', 'K' };
+    const uint16_t CHECKPOINT_VERSION = 3;
+    const int MAX_FOR_DEPTH = 8;
+
+    // Read-only mapping of a whole file; restore decodes straight out of the page cache
+    class MappedFile {
+    private:
+        const char* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#endif
+
+    public:
+        explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+            file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return;
+            LARGE_INTEGER length;
+            if (!GetFileSizeEx(file, &length) || length.QuadPart == 0) return;
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) return;
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (data) size = static_cast<size_t>(length.QuadPart);
+#else
+            int fd = open(filename.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            struct stat info;
+            if (fstat(fd, &info) == 0 && info.st_size > 0) {
+                void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view != MAP_FAILED) {
+                    data = static_cast<const char*>(view);
+                    size = static_cast<size_t>(info.st_size);
+                }
+            }
+            close(fd);
+#endif
+        }
+
+        ~MappedFile() {
+#ifdef _WIN32
+            if (data) UnmapViewOfFile(data);
+            if (mapping) CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+            if (data) munmap(const_cast<char*>(data), size);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* getData() const { return data; }
+        size_t getSize() const { return size; }
+    };
+
+    void writeProcess(CheckpointWriter& out, const Process& proc, const std::vector<char>& region) {
+        out.putString(proc.name);
+        out.putI32(proc.pid);
+        out.putU32(proc.seed);
+        out.putI32(proc.instructionPointer);
+        out.putI32(proc.totalInstructions);
+        out.putI32(proc.completedInstructions->load());
+        out.putU32(static_cast<uint32_t>(proc.getRequiredMemory()));
+        out.putI32(proc.getBaseAddress());
+        out.putI32(proc.arrivalTick);
+        out.putI32(proc.firstDispatchTick);
+        out.putI32(proc.readySinceTick);
+        out.putI32(proc.waitingTicks);
+        out.putI32(proc.preemptions);
+        out.putI32(proc.migrations);
+        out.putI32(proc.getWakeupTick());
+        out.putString(proc.arrivalTime);
+        out.putString(proc.startTime);
+
+        // Sorted so the same state always produces the same bytes
+        std::vector<std::pair<std::string, uint16_t>> variables(proc.memory.begin(), proc.memory.end());
+        std::sort(variables.begin(), variables.end());
+        out.putU16(static_cast<uint16_t>(variables.size()));
+        for (const auto& var : variables) {
+            out.putString(var.first);
+            out.putU16(var.second);
+        }
+
+        out.putU32(static_cast<uint32_t>(region.size()));
+        out.bytes.insert(out.bytes.end(), region.begin(), region.end());
+
+        out.putU32(static_cast<uint32_t>(proc.instructions.size()));
+        for (const auto& instruction : proc.instructions) instruction->serialize(out);
+
+        // Only the in-memory window of the log; older lines already went to the spill file
+        size_t total = proc.logs.size();
+        size_t resident = proc.logs.residentSize();
+        std::vector<std::string> lines = proc.logs.lines(total - resident, resident);
+        out.putU32(static_cast<uint32_t>(lines.size()));
+        for (const auto& line : lines) out.putString(line);
+    }
+
+    std::shared_ptr<Process> readProcess(CheckpointReader& in, std::vector<char>& region) {
+        auto proc = std::make_shared<Process>();
+        proc->name = in.getString();
+        proc->pid = in.getI32();
+        proc->seed = in.getU32();
+        proc->instructionPointer = in.getI32();
+        proc->totalInstructions = in.getI32();
+        *proc->completedInstructions = in.getI32();
+        proc->setRequiredMemory(in.getU32());
+        proc->setBaseAddress(in.getI32());
+        proc->arrivalTick = in.getI32();
+        proc->firstDispatchTick = in.getI32();
+        proc->readySinceTick = in.getI32();
+        proc->waitingTicks = in.getI32();
+        proc->preemptions = in.getI32();
+        proc->migrations = in.getI32();
+        proc->setWakeupTick(in.getI32());
+        proc->arrivalTime = in.getString();
+        proc->startTime = in.getString();
+
+        uint16_t variables = in.getU16();
+        for (uint16_t i = 0; i < variables && in.ok(); ++i) {
+            std::string name = in.getString();
+            proc->memory[name] = in.getU16();
+        }
+
+        in.getBytes(region, in.getU32());
+
+        uint32_t count = in.getU32();
+        for (uint32_t i = 0; i < count && in.ok(); ++i) {
+            auto instruction = readInstruction(in);
+            if (!instruction) return nullptr;
+            proc->instructions.push_back(instruction);
+        }
+
+        uint32_t lines = in.getU32();
+        for (uint32_t i = 0; i < lines && in.ok(); ++i) proc->logs.push_back(in.getString());
+
+        if (!in.ok() || proc->instructionPointer < 0 ||
+            proc->instructionPointer > static_cast<int>(proc->instructions.size())) return nullptr;
+        return proc;
+    }
+}
+
+void CheckpointWriter::putU16(uint16_t v) {
+    bytes.push_back(static_cast<char>(v & 0xFF));
+    bytes.push_back(static_cast<char>((v >> 8) & 0xFF));
+}
+
+void CheckpointWriter::putU32(uint32_t v) {
+    for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void CheckpointWriter::putString(const std::string& s) {
+    size_t length = std::min<size_t>(s.size(), 0xFFFF);
+    putU16(static_cast<uint16_t>(length));
+    bytes.insert(bytes.end(), s.begin(), s.begin() + length);
+}
+
+bool CheckpointReader::take(size_t count) {
+    if (failed || static_cast<size_t>(end - pos) < count) {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+uint8_t CheckpointReader::getU8() {
+    if (!take(1)) return 0;
+    return static_cast<uint8_t>(*pos++);
+}
+
+uint16_t CheckpointReader::getU16() {
+    if (!take(2)) return 0;
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(pos);
+    pos += 2;
+    return static_cast<uint16_t>(b[0] | (b[1] << 8));
+}
+
+uint32_t CheckpointReader::getU32() {
+    if (!take(4)) return 0;
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(pos);
+    pos += 4;
+    return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+        (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+}
+
+std::string CheckpointReader::getString() {
+    uint16_t length = getU16();
+    if (!take(length)) return std::string();
+    std::string s(pos, length);
+    pos += length;
+    return s;
+}
+
+void CheckpointReader::getBytes(std::vector<char>& out, size_t count) {
+    out.clear();
+    if (!take(count)) return;
+    out.assign(pos, pos + count);
+    pos += count;
+}
+
+std::shared_ptr<Instruction> readInstruction(CheckpointReader& in, int depth) {
+    auto tag = static_cast<InstructionTag>(in.getU8());
+    switch (tag) {
+    case InstructionTag::DECLARE: {
+        std::string var = in.getString();
+        uint16_t value = in.getU16();
+        return std::make_shared<DeclareInstruction>(var, value, in.getString());
+    }
+    case InstructionTag::ADD:
+    case InstructionTag::SUBTRACT: {
+        std::string result = in.getString();
+        std::string lhs = in.getString();
+        std::string rhs = in.getString();
+        std::string prefix = in.getString();
+        if (tag == InstructionTag::ADD) return std::make_shared<AddInstruction>(result, lhs, rhs, prefix);
+        return std::make_shared<SubtractInstruction>(result, lhs, rhs, prefix);
+    }
+    case InstructionTag::PRINT: {
+        std::string message = in.getString();
+        std::string var = in.getString();
+        bool hasVariable = in.getU8() != 0;
+        return std::make_shared<PrintInstruction>(message, var, hasVariable, in.getString());
+    }
+    case InstructionTag::SLEEP: {
+        int ms = in.getI32();
+        return std::make_shared<SleepInstruction>(ms, in.getString());
+    }
+    case InstructionTag::READ: {
+        std::string var = in.getString();
+        uint32_t address = in.getU32();
+        return std::make_shared<ReadInstruction>(var, address, in.getString());
+    }
+    case InstructionTag::WRITE: {
+        uint32_t address = in.getU32();
+        std::string value = in.getString();
+        return std::make_shared<WriteInstruction>(address, value, in.getString());
+    }
+    case InstructionTag::FOR: {
+        if (depth >= MAX_FOR_DEPTH) return nullptr;
+        int iterations = in.getI32();
+        int nesting = in.getI32();
+        uint32_t count = in.getU32();
+        std::vector<std::shared_ptr<Instruction>> body;
+        for (uint32_t i = 0; i < count && in.ok(); ++i) {
+            auto instruction = readInstruction(in, depth + 1);
+            if (!instruction) return nullptr;
+            body.push_back(instruction);
+        }
+        return std::make_shared<ForInstruction>(iterations, body, nesting);
+    }
+    }
+    return nullptr;
+}
+
+CheckpointWriter encodeCheckpoint(const CheckpointState& state) {
+    CheckpointWriter out;
+    out.bytes.insert(out.bytes.end(), CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + 4);
+    out.putU16(CHECKPOINT_VERSION);
+    out.putI32(state.tick);
+    out.putI32(state.nextPid);
+    out.putI32(state.nextUniqueName);
+    out.putU8(state.generating ? 1 : 0);
+    out.putU16(static_cast<uint16_t>(state.numCPU));
+    out.putU8(state.roundRobin ? 1 : 0);
+    out.putU32(static_cast<uint32_t>(state.quantum));
+    out.putU32(static_cast<uint32_t>(state.delay));
+    out.putU32(static_cast<uint32_t>(state.minIns));
+    out.putU32(static_cast<uint32_t>(state.maxIns));
+    out.putU32(static_cast<uint32_t>(state.memPerProc));
+    out.putU32(static_cast<uint32_t>(state.batchFreq));
+    out.putU32(static_cast<uint32_t>(state.runningCount));
+    out.putU32(static_cast<uint32_t>(state.processes.size()));
+    for (size_t i = 0; i < state.processes.size(); ++i) {
+        writeProcess(out, *state.processes[i], i < state.regions.size() ? state.regions[i] : std::vector<char>());
+    }
+    return out;
+}
+
+bool saveCheckpoint(const std::string& filename, const CheckpointWriter& encoded) {
+    // Write beside the target and rename, so a crash mid-write never clobbers the last good checkpoint
+    std::string temp = filename + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(encoded.bytes.data(), static_cast<std::streamsize>(encoded.bytes.size()));
+        if (!file) return false;
+    }
+    std::remove(filename.c_str());
+    return std::rename(temp.c_str(), filename.c_str()) == 0;
+}
+
+bool loadCheckpoint(const std::string& filename, CheckpointState& state) {
+    MappedFile file(filename);
+    if (!file.getData() || file.getSize() < 4 ||
+        !std::equal(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + 4, file.getData())) return false;
+
+    CheckpointReader in(file.getData() + 4, file.getSize() - 4);
+    if (in.getU16() != CHECKPOINT_VERSION) return false;
+    state.tick = in.getI32();
+    state.nextPid = in.getI32();
+    state.nextUniqueName = in.getI32();
+    state.generating = in.getU8() != 0;
+    state.numCPU = in.getU16();
+    state.roundRobin = in.getU8() != 0;
+    state.quantum = static_cast<int>(in.getU32());
+    state.delay = static_cast<int>(in.getU32());
+    state.minIns = static_cast<int>(in.getU32());
+    state.maxIns = static_cast<int>(in.getU32());
+    state.memPerProc = in.getU32();
+    state.batchFreq = static_cast<int>(in.getU32());
+    state.runningCount = in.getU32();
+    uint32_t count = in.getU32();
+    if (!in.ok() || state.numCPU <= 0) return false;
+
+    // count is untrusted, so nothing is sized from it; a short file stops the loop through ok()
+    state.processes.clear();
+    state.regions.clear();
+    for (uint32_t i = 0; i < count && in.ok(); ++i) {
+        std::vector<char> region;
+        auto proc = readProcess(in, region);
+        if (!proc) return false;
+        state.processes.push_back(proc);
+        state.regions.push_back(std::move(region));
+    }
+    return in.ok();
+}
@@ -0,0 +1,92 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "process.h"
+
+// Checkpoint layout (little endian):
+//   header  : "CSCK" u16 version, i32 tick, i32 nextPid, i32 nextUniqueName, u8 generating,
+//             u16 numCPU, u8 scheduler, u32 quantum, u32 delay, u32 minIns, u32 maxIns,
+//             u32 memPerProc, u32 batchFreq, u32 runningCount, u32 processCount
+//   process : strings are u16 length + bytes
+//             name, i32 pid, u32 seed, i32 ip, i32 total, i32 completed, u32 requiredMemory,
+//             i32 baseAddress, i32 arrivalTick, i32 firstDispatchTick, i32 readySinceTick,
+//             i32 waitingTicks, i32 preemptions, i32 migrations, i32 wakeupTick, arrivalTime, startTime,
+//             u16 variables (name, u16 value), u32 region bytes + bytes (trailing zeros dropped),
+//             u32 instructions, u32 log lines (string each)
+//   instruction: u8 tag then operands (see InstructionTag)
+// The first runningCount processes were on a core; they are queued first on restore.
+enum class InstructionTag : uint8_t {
+    DECLARE = 1,   // var, u16 value, prefix
+    ADD = 2,       // result, lhs, rhs, prefix
+    SUBTRACT = 3,  // result, lhs, rhs, prefix
+    PRINT = 4,     // message, var, u8 hasVariable, prefix
+    SLEEP = 5,     // i32 ms, prefix
+    FOR = 6,       // i32 iterations, i32 nesting, u32 count, nested instructions
+    READ = 7,      // var, u32 address, prefix
+    WRITE = 8      // u32 address, value, prefix
+};
+
+class Instruction;
+
+class CheckpointWriter {
+public:
+    std::vector<char> bytes;
+
+    void putU8(uint8_t v) { bytes.push_back(static_cast<char>(v)); }
+    void putU16(uint16_t v);
+    void putU32(uint32_t v);
+    void putI32(int32_t v) { putU32(static_cast<uint32_t>(v)); }
+    void putString(const std::string& s);
+};
+
+// Bounds-checked cursor over the mapped file; a short read marks it failed and yields zeros
+class CheckpointReader {
+private:
+    const char* pos;
+    const char* end;
+    bool failed = false;
+
+    bool take(size_t count);
+
+public:
+    CheckpointReader(const char* data, size_t size) : pos(data), end(data + size) {}
+
+    uint8_t getU8();
+    uint16_t getU16();
+    uint32_t getU32();
+    int32_t getI32() { return static_cast<int32_t>(getU32()); }
+    std::string getString();
+    void getBytes(std::vector<char>& out, size_t count);
+    bool ok() const { return !failed; }
+};
+
+struct CheckpointState {
+    int tick = 0;
+    int nextPid = 1000;
+    int nextUniqueName = 1;
+    bool generating = false;
+    int numCPU = 0;
+    bool roundRobin = true;
+    int quantum = 0;
+    int delay = 0;
+    int minIns = 0;
+    int maxIns = 0;
+    size_t memPerProc = 0;
+    int batchFreq = 1;
+    size_t runningCount = 0;
+    std::vector<std::shared_ptr<Process>> processes;  // on-core processes, then the ready queue in order
+    std::vector<std::vector<char>> regions;           // memory region contents, parallel to processes
+};
+
+// Encoding is separate from writing so the cores only stay parked while memory is copied
+CheckpointWriter encodeCheckpoint(const CheckpointState& state);
+bool saveCheckpoint(const std::string& filename, const CheckpointWriter& encoded);
+bool loadCheckpoint(const std::string& filename, CheckpointState& state);
+
+std::shared_ptr<Instruction> readInstruction(CheckpointReader& in, int depth = 0);
+
+#endif // CHECKPOINT_H
@@ -5,7 +5,9 @@
 #include <thread>
 #include <chrono>
 #include <iomanip>
-#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -22,87 +24,221 @@ void ConsoleView::clearScreen() {
 
 void ConsoleView::show(const std::shared_ptr<Process>& proc) {
     std::string input;
+    size_t scrollBack = 0;
 
     while (true) {
         clearScreen();
-        displayProcessScreen(proc);
+        displayProcessScreen(proc, scrollBack);
 
         std::cout << "\n" << proc->name << ":\\> ";
         std::getline(std::cin, input);
 
+        std::istringstream iss(input);
+        std::string cmd;
+        size_t amount = LOG_PAGE;
+        iss >> cmd >> amount;
+        if (amount == 0) amount = LOG_PAGE;
+        size_t total = proc->logs.size();
+
         if (input == "exit") {
             break; 
         }
+        else if (cmd == "up") {
+            scrollBack = std::min(scrollBack + amount, total > LOG_PAGE ? total - LOG_PAGE : 0);
+        }
+        else if (cmd == "down") {
+            scrollBack = scrollBack > amount ? scrollBack - amount : 0;
+        }
+        else if (cmd == "top") {
+            scrollBack = total > LOG_PAGE ? total - LOG_PAGE : 0;
+        }
+        else if (cmd == "bottom") {
+            scrollBack = 0;
+        }
+        else if (input == "watch") {
+            watch(proc);
+            scrollBack = 0;
+        }
         else if (input == "process-smi") {
             clearScreen();
             std::cout << "Process name: " << proc->name << std::endl;
             std::cout << "ID: " << proc->pid << std::endl;
-            std::cout << "Logs:\n";
-            if (proc->logs.empty()) {
-                std::cout << "  [No logs available]\n";
-            }
-            else {
-                for (const auto& log : proc->logs) {
-                    std::cout << log << "\n";
-                }
-            }
+            printLogWindow(proc, scrollBack);
 
-            std::cout << "\nCurrent instruction line: " << (proc->isFinished ? static_cast<int>(proc->instructions.size()) : proc->instructionPointer + 1) << std::endl;
-            std::cout << "Lines of code: " << proc->instructions.size() << std::endl;
+            std::cout << "\nCurrent instruction line: " << (proc->isFinished ? proc->totalInstructions : proc->instructionPointer + 1) << std::endl;
+            std::cout << "Lines of code: " << proc->totalInstructions << std::endl;
+            std::cout << "Core migrations: " << proc->migrations << std::endl;
+            std::cout << "Page faults: " << proc->pageFaults << " (" << proc->pageEvictions << " evicted, "
+                << proc->pageWritebacks << " written back)" << std::endl;
 
             if (proc->isFinished) {
                 std::cout << "\nFinished!" << std::endl;
             }
         }
         else if (!input.empty()) {
-            std::cout << "Unknown command: " << input << ". Available commands: process-smi, exit\n";
+            std::cout << "Unknown command: " << input << ". Available commands: process-smi, watch, up [n], down [n], top, bottom, exit\n";
             std::cout << "Press [Enter] to continue...";
             std::cin.get();
         }
     }
 }
 
-void ConsoleView::displayProcessScreen(const std::shared_ptr<Process>& proc) {
-    std::cout << "+--------------------------------------+\n";
-    std::cout << "|         PROCESS CONSOLE VIEW         |\n";
-    std::cout << "+--------------------------------------+\n";
-    std::cout << "| Process Name : " << proc->name << "\n";
-    std::cout << "| PID          : " << proc->pid << "\n";
-    std::cout << "| Core Assigned: " << proc->coreAssigned << "\n";
-    std::cout << "| Start Time   : " << proc->startTime << "\n";
-    std::cout << "| End Time     : " << (proc->isFinished ? proc->endTime : "N/A") << "\n";
-    std::cout << "| Instructions : " << *proc->completedInstructions << " / " << proc->instructions.size() << "\n";
-    std::cout << "+--------------------------------------+\n";
-
-    std::cout << "\nLogs:\n";
-    if (proc->logs.empty()) {
-        std::cout << "  [No logs available]\n";
+void ConsoleView::printLogWindow(const std::shared_ptr<Process>& proc, size_t scrollBack) {
+    size_t total = proc->logs.size();
+    if (total == 0) {
+        std::cout << "Logs:\n  [No logs available]\n";
+        return;
     }
-    else {
-        for (const auto& log : proc->logs) {
-            std::cout << log << "\n";
-        }
+
+    size_t end = total - std::min(scrollBack, total);
+    size_t first = end > LOG_PAGE ? end - LOG_PAGE : 0;
+    std::cout << "Logs (lines " << first + 1 << "-" << end << " of " << total << "):\n";
+    if (first > 0) std::cout << "  ... " << first << " earlier lines (up [n] to scroll)\n";
+    for (const auto& log : proc->logs.lines(first, end - first)) {
+        std::cout << log << "\n";
     }
+    if (end < total) std::cout << "  ... " << total - end << " newer lines (down [n] to scroll)\n";
+}
 
-    std::cout << "\nCurrent instruction line: " << (proc->isFinished ? static_cast<int>(proc->instructions.size()) : proc->instructionPointer + 1) << "\n";
-    std::cout << "Lines of code: " << proc->instructions.size() << "\n";
+std::vector<std::string> ConsoleView::headerRows(const std::shared_ptr<Process>& proc) {
+    return {
+        "+--------------------------------------+",
+        "|         PROCESS CONSOLE VIEW         |",
+        "+--------------------------------------+",
+        "| Process Name : " + proc->name,
+        "| PID          : " + std::to_string(proc->pid),
+        "| Core Assigned: " + std::to_string(proc->coreAssigned.load()),
+        "| Start Time   : " + proc->startTime,
+        "| End Time     : " + (proc->isFinished ? proc->endTime : std::string("N/A")),
+        "| Instructions : " + std::to_string(proc->completedInstructions->load()) + " / " + std::to_string(proc->totalInstructions),
+        "| Migrations   : " + std::to_string(proc->migrations),
+        "| Page faults  : " + std::to_string(proc->pageFaults.load()) + " (" + std::to_string(proc->pageEvictions.load())
+            + " evicted, " + std::to_string(proc->pageWritebacks.load()) + " written back)",
+        "+--------------------------------------+"
+    };
+}
 
-    std::cout << "\nStatus: ";
+std::string ConsoleView::statusText(const std::shared_ptr<Process>& proc) {
     if (proc->isFinished) {
-        if (*proc->completedInstructions == static_cast<int>(proc->instructions.size())) {
-            std::cout << "[OK] Finished successfully.\n";
-            std::cout << "Finished!\n";
-        }
-        else {
-            std::cout << "[ERROR] Terminated early due to error at instruction "
-                << proc->instructionPointer + 1 << ".\n";
+        if (*proc->completedInstructions == proc->totalInstructions) return "[OK] Finished successfully.";
+        if (!proc->terminationReason.empty()) {
+            return "[ERROR] Terminated at instruction " + std::to_string(proc->instructionPointer + 1) + ": " + proc->terminationReason + ".";
         }
+        return "[ERROR] Terminated early due to error at instruction " + std::to_string(proc->instructionPointer + 1) + ".";
+    }
+    return proc->isRunning ? "[RUNNING] Currently running." : "[WAITING] Queued or waiting.";
+}
+
+void ConsoleView::displayProcessScreen(const std::shared_ptr<Process>& proc, size_t scrollBack) {
+    for (const auto& row : headerRows(proc)) {
+        std::cout << row << "\n";
     }
-    else if (proc->isRunning) {
-        std::cout << "[RUNNING] Currently running.\n";
+
+    std::cout << "\n";
+    printLogWindow(proc, scrollBack);
+
+    std::cout << "\nCurrent instruction line: " << (proc->isFinished ? proc->totalInstructions : proc->instructionPointer + 1) << "\n";
+    std::cout << "Lines of code: " << proc->totalInstructions << "\n";
+
+    std::cout << "\nStatus: " << statusText(proc) << "\n";
+    if (proc->isFinished && *proc->completedInstructions == proc->totalInstructions) {
+        std::cout << "Finished!\n";
     }
-    else {
-        std::cout << "[WAITING] Queued or waiting.\n";
+    std::cout << "\nAvailable commands: process-smi, watch, up [n], down [n], top, bottom, exit";
+}
+
+namespace {
+    // Fixed layout of the live view: header rows, a blank line, the log title, then the log region
+    const int LOG_TOP_ROW = 15;
+    const int LOG_BOTTOM_ROW = LOG_TOP_ROW + static_cast<int>(ConsoleView::LOG_PAGE) - 1;
+    const int STATUS_ROW = LOG_BOTTOM_ROW + 2;
+    const size_t MAX_LINE = 160;
+
+    void putRow(int row, const std::string& text) {
+        std::cout << "\033[" << row << ";1H" << text.substr(0, MAX_LINE) << "\033[K";
     }
-    std::cout << "\nAvailable commands: process-smi, exit";
+
+    void enableAnsi() {
+#ifdef _WIN32
+        HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (GetConsoleMode(out, &mode)) SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+    }
+}
+
+// The cores never wait on this view: it sleeps on the log's append notification
+// (which is only signalled while a viewer is attached) and polls the header fields
+// on the same timeout. Only rows whose text changed are rewritten, and new log
+// lines are added by scrolling the log region instead of repainting the screen.
+void ConsoleView::watch(const std::shared_ptr<Process>& proc) {
+    enableAnsi();
+    std::atomic<bool> detach{ false };
+    std::thread input([&detach] {
+        std::string line;
+        std::getline(std::cin, line);
+        detach = true;
+        });
+
+    std::cout << "\033[2J";
+    std::vector<std::string> header = headerRows(proc);
+    for (size_t i = 0; i < header.size(); ++i) putRow(static_cast<int>(i) + 1, header[i]);
+    putRow(LOG_TOP_ROW - 1, "Logs (live):");
+
+    size_t seen = proc->logs.size();
+    size_t first = seen > LOG_PAGE ? seen - LOG_PAGE : 0;
+    int filled = 0;
+    for (const auto& line : proc->logs.lines(first, seen - first)) {
+        putRow(LOG_TOP_ROW + filled++, line);
+    }
+
+    std::string status = statusText(proc);
+    putRow(STATUS_ROW, "Status: " + status);
+    putRow(STATUS_ROW + 1, "Watching " + proc->name + " - press [Enter] to return.");
+    std::cout << "\033[" << LOG_TOP_ROW << ";" << LOG_BOTTOM_ROW << "r";
+    std::cout.flush();
+
+    while (!detach) {
+        size_t total = proc->logs.waitForAppend(seen, std::chrono::milliseconds(250));
+
+        bool changed = false;
+        std::vector<std::string> rows = headerRows(proc);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (rows[i] == header[i]) continue;
+            putRow(static_cast<int>(i) + 1, rows[i]);
+            changed = true;
+        }
+        header.swap(rows);
+
+        if (total > seen) {
+            size_t from = std::max(seen, total > LOG_PAGE ? total - LOG_PAGE : 0);
+            for (const auto& line : proc->logs.lines(from, total - from)) {
+                if (filled < static_cast<int>(LOG_PAGE)) {
+                    putRow(LOG_TOP_ROW + filled++, line);
+                }
+                else {
+                    // A newline on the region's last row scrolls only the log lines up
+                    std::cout << "\033[" << LOG_BOTTOM_ROW << ";1H\n";
+                    putRow(LOG_BOTTOM_ROW, line);
+                }
+            }
+            seen = total;
+            changed = true;
+        }
+
+        std::string now = statusText(proc);
+        if (now != status) {
+            putRow(STATUS_ROW, "Status: " + now);
+            status = now;
+            changed = true;
+        }
+        if (changed) {
+            std::cout << "\033[" << STATUS_ROW + 2 << ";1H";
+            std::cout.flush();
+        }
+    }
+
+    std::cout << "\033[r";
+    std::cout.flush();
+    input.join();
 }
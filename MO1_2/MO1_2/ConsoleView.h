@@ -1,10 +1,23 @@
 #pragma once
 #include <memory>
+#include <string>
+#include <vector>
 #include "process.h"
 
 class ConsoleView {
 public:
+    static const size_t LOG_PAGE = 20;
+
     static void show(const std::shared_ptr<Process>& proc);               // <- NEW
-    static void displayProcessScreen(const std::shared_ptr<Process>& proc);
+    // scrollBack = log lines hidden below the window; 0 shows the newest page
+    static void displayProcessScreen(const std::shared_ptr<Process>& proc, size_t scrollBack = 0);
+    static void printLogWindow(const std::shared_ptr<Process>& proc, size_t scrollBack);
     static void clearScreen();
+
+    // Live view: redraws only changed fields and appends new log lines until Enter is pressed
+    static void watch(const std::shared_ptr<Process>& proc);
+
+private:
+    static std::vector<std::string> headerRows(const std::shared_ptr<Process>& proc);
+    static std::string statusText(const std::shared_ptr<Process>& proc);
 };
@@ -1,4 +1,5 @@
 #include "DeclareInstruction.h"
+#include "Checkpoint.h"
 #include "process.h"
 #include "utils.h"
 #include <sstream>
@@ -16,3 +17,14 @@ void DeclareInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
     proc->logs.push_back(logEntry.str());
     logToFile(proc->name, logEntry.str(), coreId);
 }
+
+void DeclareInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::DECLARE));
+    out.putString(variableName);
+    out.putU16(value);
+    out.putString(logPrefix);
+}
+
+Opcode DeclareInstruction::opcode() const {
+    return Opcode::DECLARE;
+}
@@ -1,7 +1,7 @@
 #ifndef DECLAREINSTRUCTION_H
 #define DECLAREINSTRUCTION_H
 
-#include "instruction.h"
+#include "Instruction.h"
 #include <string>
 #include <memory>
 #include <cstdint>
@@ -15,6 +15,8 @@ private:
 public:
     DeclareInstruction(const std::string& varName, int val, const std::string& logPrefix="");
     void execute(std::shared_ptr<Process> proc, int coreId = -1) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
 
     std::string getVariableName() const { return variableName; }
     uint16_t getValue() const { return value; }
@@ -1,4 +1,5 @@
 #include "ForInstruction.h"
+#include "Checkpoint.h"
 #include "utils.h"
 #include "process.h"
 
@@ -18,3 +19,15 @@ void ForInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
         }
     }
 }
+
+void ForInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::FOR));
+    out.putI32(iterations);
+    out.putI32(nestingLevel);
+    out.putU32(static_cast<uint32_t>(subInstructions.size()));
+    for (const auto& instruction : subInstructions) instruction->serialize(out);
+}
+
+Opcode ForInstruction::opcode() const {
+    return Opcode::FOR;
+}
@@ -1,7 +1,7 @@
 #ifndef FORINSTRUCTION_H
 #define FORINSTRUCTION_H
 
-#include "instruction.h"
+#include "Instruction.h"
 #include <vector>
 #include <memory>
 
@@ -14,6 +14,8 @@ private:
 public:
     ForInstruction(int count, const std::vector<std::shared_ptr<Instruction>>& instructions, int nesting = 1);
     void execute(std::shared_ptr<Process> proc, int coreId) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
     int getIterations() const { return iterations; }
     int getNestingLevel() const { return nestingLevel; }
 };
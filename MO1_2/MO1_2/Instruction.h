@@ -2,13 +2,20 @@
 #define INSTRUCTION_H
 
 #include <memory>
+#include <cstdint>
 
 struct Process;
+class CheckpointWriter;
+enum class Opcode : uint8_t;
 
 class Instruction {
 public:
     virtual ~Instruction() = default;
     virtual void execute(std::shared_ptr<Process> proc, int coreId) = 0;
+    // Appends the instruction's tag and operands to a checkpoint (see Checkpoint.h)
+    virtual void serialize(CheckpointWriter& out) const = 0;
+    // Which profiler row the instruction's executions are counted under
+    virtual Opcode opcode() const = 0;
 };
 
 #endif
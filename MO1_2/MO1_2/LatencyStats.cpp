@@ -0,0 +1,157 @@
+#include "LatencyStats.h"
+#include <cmath>
+#include <iomanip>
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) return static_cast<int>(value);
+
+    int msb = 0;
+    while ((value >> (msb + 1)) != 0) msb++;
+    int exponent = msb - 4;
+    int sub = static_cast<int>(value >> exponent);
+    int index = SUB_BUCKETS + (exponent - 1) * HALF_SUB_BUCKETS + (sub - HALF_SUB_BUCKETS);
+    return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) return static_cast<uint64_t>(index);
+    int exponent = (index - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+    uint64_t sub = static_cast<uint64_t>((index - SUB_BUCKETS) % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS);
+    return ((sub + 1) << exponent) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t prev = maxValue.load(std::memory_order_relaxed);
+    while (value > prev && !maxValue.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    count = 0;
+    sum = 0;
+    maxValue = 0;
+}
+
+double LatencyHistogram::getMean() const {
+    uint64_t n = getCount();
+    return n == 0 ? 0.0 : static_cast<double>(sum.load(std::memory_order_relaxed)) / n;
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    uint64_t n = getCount();
+    if (n == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * n));
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            uint64_t upper = bucketUpperBound(i);
+            return upper < getMax() ? upper : getMax();
+        }
+    }
+    return getMax();
+}
+
+LatencyStats& LatencyStats::getInstance() {
+    static LatencyStats instance;
+    return instance;
+}
+
+void LatencyStats::recordCompletion(SchedulerType type, int waitingTicks, int responseTicks, int turnaroundTicks, int preemptions) {
+    auto& slot = perScheduler[slotFor(type)];
+    slot.waiting.record(waitingTicks > 0 ? waitingTicks : 0);
+    slot.response.record(responseTicks > 0 ? responseTicks : 0);
+    slot.turnaround.record(turnaroundTicks > 0 ? turnaroundTicks : 0);
+    slot.preemptions.fetch_add(preemptions, std::memory_order_relaxed);
+}
+
+void LatencyStats::reset() {
+    for (auto& slot : perScheduler) {
+        slot.waiting.reset();
+        slot.response.reset();
+        slot.turnaround.reset();
+        slot.preemptions = 0;
+    }
+}
+
+void LatencyStats::writeReport(std::ostream& out) const {
+    static const char* names[] = { "FCFS", "Round Robin" };
+    std::ios_base::fmtflags flags(out.flags());
+    std::streamsize precision = out.precision();
+
+    out << "Latency (in ticks):\n";
+    bool any = false;
+    for (int i = 0; i < static_cast<int>(perScheduler.size()); ++i) {
+        const auto& slot = perScheduler[i];
+        uint64_t completed = slot.turnaround.getCount();
+        if (completed == 0) continue;
+        any = true;
+
+        out << names[i] << " - " << completed << " completed, "
+            << slot.preemptions.load(std::memory_order_relaxed) << " preemptions\n";
+        out << "  " << std::left << std::setw(12) << "metric"
+            << std::right << std::setw(10) << "mean" << std::setw(8) << "p50" << std::setw(8) << "p90"
+            << std::setw(8) << "p99" << std::setw(8) << "p99.9" << std::setw(8) << "max" << "\n";
+
+        const std::pair<const char*, const LatencyHistogram*> rows[] = {
+            { "waiting", &slot.waiting },
+            { "response", &slot.response },
+            { "turnaround", &slot.turnaround }
+        };
+        for (const auto& row : rows) {
+            const auto& h = *row.second;
+            out << "  " << std::left << std::setw(12) << row.first << std::right
+                << std::setw(10) << std::fixed << std::setprecision(2) << h.getMean()
+                << std::setw(8) << h.getPercentile(50) << std::setw(8) << h.getPercentile(90)
+                << std::setw(8) << h.getPercentile(99) << std::setw(8) << h.getPercentile(99.9)
+                << std::setw(8) << h.getMax() << "\n";
+        }
+    }
+    if (!any) out << "  No completed processes yet.\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// {"fcfs": {...}, "rr": {...}}; a scheduler with no completions is null
+void LatencyStats::writeJson(std::ostream& out) const {
+    static const char* keys[] = { "fcfs", "rr" };
+    std::ios_base::fmtflags flags(out.flags());
+    std::streamsize precision = out.precision();
+
+    out << "{";
+    for (int i = 0; i < static_cast<int>(perScheduler.size()); ++i) {
+        const auto& slot = perScheduler[i];
+        out << (i ? ", " : "") << "\"" << keys[i] << "\": ";
+        if (slot.turnaround.getCount() == 0) {
+            out << "null";
+            continue;
+        }
+
+        out << "{\"completed\": " << slot.turnaround.getCount()
+            << ", \"preemptions\": " << slot.preemptions.load(std::memory_order_relaxed);
+        const std::pair<const char*, const LatencyHistogram*> rows[] = {
+            { "waiting", &slot.waiting },
+            { "response", &slot.response },
+            { "turnaround", &slot.turnaround }
+        };
+        for (const auto& row : rows) {
+            const auto& h = *row.second;
+            out << ", \"" << row.first << "\": {\"mean\": " << std::fixed << std::setprecision(2) << h.getMean()
+                << ", \"p50\": " << h.getPercentile(50) << ", \"p90\": " << h.getPercentile(90)
+                << ", \"p99\": " << h.getPercentile(99) << ", \"max\": " << h.getMax() << "}";
+        }
+        out << "}";
+    }
+    out << "}";
+
+    out.flags(flags);
+    out.precision(precision);
+}
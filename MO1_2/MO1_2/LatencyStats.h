@@ -0,0 +1,66 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include "scheduler.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+// Log-linear (HDR style) histogram of tick values. Values below 32 are exact,
+// larger values keep their top 5 significant bits, so every bucket is within
+// ~6% of the recorded value. Recording is lock-free so cores can call it directly.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKETS = 32;
+    static constexpr int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr int BUCKET_COUNT = SUB_BUCKETS + MAX_EXPONENT * HALF_SUB_BUCKETS;
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return maxValue.load(std::memory_order_relaxed); }
+    double getMean() const;
+    uint64_t getPercentile(double percentile) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> count{ 0 };
+    std::atomic<uint64_t> sum{ 0 };
+    std::atomic<uint64_t> maxValue{ 0 };
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+};
+
+class LatencyStats {
+private:
+    LatencyStats() = default;
+
+    struct SchedulerLatency {
+        LatencyHistogram waiting;
+        LatencyHistogram response;
+        LatencyHistogram turnaround;
+        std::atomic<uint64_t> preemptions{ 0 };
+    };
+
+    std::array<SchedulerLatency, 2> perScheduler;
+
+    static int slotFor(SchedulerType type) { return type == SchedulerType::FCFS ? 0 : 1; }
+
+public:
+    static LatencyStats& getInstance();
+
+    LatencyStats(const LatencyStats&) = delete;
+    LatencyStats& operator=(const LatencyStats&) = delete;
+
+    // All values in scheduler ticks
+    void recordCompletion(SchedulerType type, int waitingTicks, int responseTicks, int turnaroundTicks, int preemptions);
+    void reset();
+    void writeReport(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+};
+
+#endif // LATENCY_STATS_H
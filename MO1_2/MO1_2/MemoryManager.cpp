@@ -1,5 +1,10 @@
 #include "MemoryManager.h"
 #include "process.h"
+#include "TraceRecorder.h"
+#include "config.h"
+#include "scheduler.h"
+#include "utils.h"
+#include "PageReplacement.h"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -8,6 +13,7 @@
 #include <ctime>
 #include <mutex>
 #include <algorithm>
+#include <unordered_map>
 
 // Static members
 std::unique_ptr<MemoryManager> MemoryManager::instance;
@@ -21,14 +27,179 @@ struct Block {
     std::shared_ptr<Process> process;
 };
 
-static std::vector<Block> memoryBlocks;
+// Contiguous allocation (page-replacement none) is split into arenas: equal slices of
+// physical memory, each with its own block list and lock. A core allocates from its own
+// arena and only visits the others, one lock at a time, when its own has no block large
+// enough. Blocks never cross an arena boundary.
+struct alignas(CACHE_LINE_SIZE) Arena {
+    std::mutex lock;
+    size_t start = 0;
+    size_t end = 0;
+    std::vector<Block> blocks;
+    // Refreshed under lock after every layout change, summed lock-free for reports
+    std::atomic<size_t> used{ 0 };
+    std::atomic<size_t> freeTotal{ 0 };
+    std::atomic<size_t> freeBlocks{ 0 };
+    std::atomic<size_t> largest{ 0 };
+    std::atomic<int> processes{ 0 };
+    std::atomic<uint64_t> allocations{ 0 };
+    std::atomic<uint64_t> frees{ 0 };
+
+    void refresh() {
+        size_t usedNow = 0, freeNow = 0, blocksNow = 0, largestNow = 0;
+        int processesNow = 0;
+        for (const auto& block : blocks) {
+            if (block.free) {
+                freeNow += block.size;
+                blocksNow++;
+                largestNow = std::max(largestNow, block.size);
+            }
+            else {
+                usedNow += block.size;
+                processesNow++;
+            }
+        }
+        used.store(usedNow, std::memory_order_relaxed);
+        freeTotal.store(freeNow, std::memory_order_relaxed);
+        freeBlocks.store(blocksNow, std::memory_order_relaxed);
+        largest.store(largestNow, std::memory_order_relaxed);
+        processes.store(processesNow, std::memory_order_relaxed);
+    }
+};
+
+static std::unique_ptr<Arena[]> arenas(new Arena[MAX_CORES]);
+static size_t arenaCount = 1;
+static size_t arenaSize = 0;
+// Guards the paging state below; reset and restoreLayout also take it while they
+// rebuild the arenas, which only happens with no core running
 static std::mutex memLock;
 
+struct ArenaTotals {
+    size_t used = 0;
+    size_t freeTotal = 0;
+    size_t freeBlocks = 0;
+    size_t largest = 0;
+    int processes = 0;
+};
+
+static ArenaTotals sumArenas() {
+    ArenaTotals totals;
+    for (size_t i = 0; i < arenaCount; ++i) {
+        const Arena& arena = arenas[i];
+        totals.used += arena.used.load(std::memory_order_relaxed);
+        totals.freeTotal += arena.freeTotal.load(std::memory_order_relaxed);
+        totals.freeBlocks += arena.freeBlocks.load(std::memory_order_relaxed);
+        totals.largest = std::max(totals.largest, arena.largest.load(std::memory_order_relaxed));
+        totals.processes += arena.processes.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+static Arena& arenaAt(size_t address) {
+    return arenas[std::min(address / std::max<size_t>(arenaSize, 1), arenaCount - 1)];
+}
+
+// Every arena's blocks in address order; arenas are locked one at a time, so a layout
+// change racing with the copy shows up in at most one arena
+static std::vector<Block> arenaLayout() {
+    std::vector<Block> layout;
+    for (size_t i = 0; i < arenaCount; ++i) {
+        std::lock_guard<std::mutex> lock(arenas[i].lock);
+        layout.insert(layout.end(), arenas[i].blocks.begin(), arenas[i].blocks.end());
+    }
+    return layout;
+}
+
+// Demand paging (page-replacement other than none). Every process gets a page table
+// instead of a block; pages are loaded into frames on first touch and written to the
+// process's swap store when a dirty page is evicted.
+struct PageTable {
+    std::shared_ptr<Process> process;
+    std::vector<long> frameOf;                               // -1 = not resident
+    std::unordered_map<size_t, std::vector<char>> swapped;   // evicted page contents
+};
+
+static std::vector<Frame> frames;
+static std::vector<size_t> freeFrames;
+static std::unordered_map<int, PageTable> pageTables;
+static std::unique_ptr<ReplacementPolicy> replacement;
+static uint64_t loadCounter = 0;
+
+AccessViolation::AccessViolation(size_t address)
+    : std::runtime_error([address] {
+        std::ostringstream message;
+        message << "memory access violation at 0x" << std::hex << std::uppercase << address;
+        return message.str();
+        }()), address(address) {
+}
+
 MemoryManager::MemoryManager() {
-    memory.resize(MEMORY_SIZE, 0);
-    memoryBlocks.clear();
-    // Initially, one big free block
-    memoryBlocks.push_back({ 0, MEMORY_SIZE, true, nullptr });
+    tlbCount = MAX_CORES;
+    tlbs.reset(new SoftwareTlb[tlbCount]);
+    configureMemory();
+    configureArenas();
+    configurePaging();
+    refreshStats();
+}
+
+// Maps max-overall-mem bytes, or hands the old mapping's pages back when the size is
+// unchanged; called with memLock held (or before any use)
+void MemoryManager::configureMemory() {
+    size_t wanted = Config::getInstance().maxOverallMem;
+    if (wanted == memorySize && memory.data()) {
+        memory.discard();
+        return;
+    }
+    if (wanted > 0 && memory.reserve(wanted)) {
+        memorySize = wanted;
+        return;
+    }
+    std::cout << "Could not reserve " << wanted << " bytes of emulated memory; using "
+        << DEFAULT_MEMORY_SIZE << ".\n";
+    memorySize = memory.reserve(DEFAULT_MEMORY_SIZE) ? DEFAULT_MEMORY_SIZE : 0;
+}
+
+// Splits memory into memory-arenas slices (one per core when 0), each starting as one
+// free block; called with memLock held (or before any use)
+void MemoryManager::configureArenas() {
+    const Config& config = Config::getInstance();
+    size_t wanted = config.memoryArenas > 0 ? static_cast<size_t>(config.memoryArenas)
+        : static_cast<size_t>(std::max(config.numCPU, 1));
+    // An arena smaller than the largest process could never place it
+    size_t largestProcess = std::max({ config.memPerProc, config.maxMemPerProc, size_t{ 1 } });
+    arenaCount = std::max<size_t>(std::min({ wanted, memorySize / largestProcess, static_cast<size_t>(MAX_CORES) }), 1);
+    arenaSize = memorySize / arenaCount;
+    for (size_t i = 0; i < arenaCount; ++i) {
+        Arena& arena = arenas[i];
+        std::lock_guard<std::mutex> lock(arena.lock);
+        arena.start = i * arenaSize;
+        arena.end = i + 1 == arenaCount ? memorySize : arena.start + arenaSize;
+        arena.blocks.clear();
+        arena.blocks.push_back({ arena.start, arena.end - arena.start, true, nullptr });
+        arena.refresh();
+    }
+    for (size_t i = arenaCount; i < static_cast<size_t>(MAX_CORES); ++i) {
+        std::lock_guard<std::mutex> lock(arenas[i].lock);
+        arenas[i].blocks.clear();
+        arenas[i].refresh();
+    }
+}
+
+// Reads mem-per-frame and page-replacement; called with memLock held (or before any use)
+void MemoryManager::configurePaging() {
+    const Config& config = Config::getInstance();
+    pageSize = std::max<size_t>(config.memPerFrame, 2);
+    replacement = config.pageReplacement == "none" ? nullptr : makeReplacementPolicy(config.pageReplacement);
+    if (!replacement && config.pageReplacement != "none") {
+        std::cout << "Unknown page-replacement \"" << config.pageReplacement << "\"; using contiguous allocation.\n";
+    }
+    paging = replacement != nullptr;
+
+    frames.assign(paging ? memorySize / pageSize : 0, Frame());
+    freeFrames.clear();
+    for (size_t i = frames.size(); i > 0; --i) freeFrames.push_back(i - 1);
+    pageTables.clear();
+    loadCounter = 0;
 }
 
 MemoryManager& MemoryManager::getInstance() {
@@ -38,11 +209,44 @@ MemoryManager& MemoryManager::getInstance() {
     return *instance;
 }
 
-bool MemoryManager::allocate(std::shared_ptr<Process> process) {
-    std::lock_guard<std::mutex> lock(memLock);
+bool MemoryManager::allocate(std::shared_ptr<Process> process, int coreId) {
+    size_t req = process->getRequiredMemory();
+
+    // Paging never refuses a process: its pages are faulted in as they are touched.
+    // Base address 0 marks it as holding memory; addresses are all page-table relative.
+    if (paging) {
+        std::lock_guard<std::mutex> lock(memLock);
+        PageTable& table = pageTables[process->pid];
+        table.process = process;
+        table.frameOf.assign((req + pageSize - 1) / pageSize, -1);
+        table.swapped.clear();
+        process->setBaseAddress(0);
+        TraceRecorder::getInstance().record(TraceEventType::ALLOC, coreId, process->pid, 0);
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        refreshStats();
+        return true;
+    }
+
+    // The core's own arena first, then the others in order from the next one
+    size_t home = coreId >= 0 ? static_cast<size_t>(coreId) % arenaCount : 0;
+    for (size_t i = 0; i < arenaCount; ++i) {
+        if (!allocateIn(arenas[(home + i) % arenaCount], process, coreId)) continue;
+        if (i > 0) arenaSteals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    TraceRecorder::getInstance().record(TraceEventType::ALLOC_FAIL, coreId, process->pid, static_cast<uint32_t>(req));
+    allocationFailures.fetch_add(1, std::memory_order_relaxed);
+    return false; // No space found
+}
+
+// First fit within one arena, under that arena's lock
+bool MemoryManager::allocateIn(Arena& arena, std::shared_ptr<Process> process, int coreId) {
+    std::lock_guard<std::mutex> lock(arena.lock);
     size_t req = process->getRequiredMemory();
+    if (arena.largest.load(std::memory_order_relaxed) < req) return false;
 
-    for (auto& block : memoryBlocks) {
+    for (auto& block : arena.blocks) {
         if (block.free && block.size >= req) {
             // Allocate here
             size_t oldStart = block.start;
@@ -52,6 +256,7 @@ bool MemoryManager::allocate(std::shared_ptr<Process> process) {
             block.size = req;
             block.process = process;
             process->setBaseAddress((int)block.start);
+            memory.clear(block.start, req);
 
             // If block is larger than needed, split it
             if (oldSize > req) {
@@ -61,46 +266,68 @@ bool MemoryManager::allocate(std::shared_ptr<Process> process) {
                 newBlock.free = true;
                 newBlock.process = nullptr;
 
-                auto it = std::find_if(memoryBlocks.begin(), memoryBlocks.end(), [&](const Block& b) {
+                auto it = std::find_if(arena.blocks.begin(), arena.blocks.end(), [&](const Block& b) {
                     return b.start == oldStart;
                     });
-                if (it != memoryBlocks.end()) {
-                    memoryBlocks.insert(std::next(it), newBlock);
+                if (it != arena.blocks.end()) {
+                    arena.blocks.insert(std::next(it), newBlock);
                 }
             }
+            TraceRecorder::getInstance().record(TraceEventType::ALLOC, coreId, process->pid, static_cast<uint32_t>(oldStart));
+            arena.allocations.fetch_add(1, std::memory_order_relaxed);
+            arena.refresh();
             return true;
         }
     }
-
-
-    return false; // No space found
+    return false;
 }
 
-void MemoryManager::deallocate(std::shared_ptr<Process> process) {
-    std::lock_guard<std::mutex> lock(memLock);
+void MemoryManager::deallocate(std::shared_ptr<Process> process, int coreId) {
+    if (process->getBaseAddress() < 0) return;
     size_t base = process->getBaseAddress();
 
-    for (auto it = memoryBlocks.begin(); it != memoryBlocks.end(); ++it) {
+    if (paging) {
+        std::lock_guard<std::mutex> lock(memLock);
+        auto table = pageTables.find(process->pid);
+        if (table == pageTables.end()) return;
+        for (long frame : table->second.frameOf) {
+            if (frame < 0) continue;
+            frames[frame] = Frame();
+            freeFrames.push_back(static_cast<size_t>(frame));
+        }
+        pageTables.erase(table);
+        TraceRecorder::getInstance().record(TraceEventType::FREE, coreId, process->pid, 0);
+        frees.fetch_add(1, std::memory_order_relaxed);
+        refreshStats();
+        return;
+    }
+
+    Arena& arena = arenaAt(base);
+    std::lock_guard<std::mutex> lock(arena.lock);
+    for (auto it = arena.blocks.begin(); it != arena.blocks.end(); ++it) {
         if (!it->free && it->start == base) {
             it->free = true;
             it->process = nullptr;
+            TraceRecorder::getInstance().record(TraceEventType::FREE, coreId, process->pid, static_cast<uint32_t>(base));
 
             // Merge adjacent free blocks
-            if (it != memoryBlocks.begin()) {
+            if (it != arena.blocks.begin()) {
                 auto prev = std::prev(it);
                 if (prev->free) {
                     prev->size += it->size;
-                    memoryBlocks.erase(it);
+                    arena.blocks.erase(it);
                     it = prev;
                 }
             }
-            if (std::next(it) != memoryBlocks.end()) {
+            if (std::next(it) != arena.blocks.end()) {
                 auto next = std::next(it);
                 if (next->free) {
                     it->size += next->size;
-                    memoryBlocks.erase(next);
+                    arena.blocks.erase(next);
                 }
             }
+            arena.frees.fetch_add(1, std::memory_order_relaxed);
+            arena.refresh();
             break;
         }
     }
@@ -108,11 +335,39 @@ void MemoryManager::deallocate(std::shared_ptr<Process> process) {
 
 void MemoryManager::incrementCycle() {
     int cycle = currentCycle.fetch_add(1) + 1;
+    if (paging) {
+        std::lock_guard<std::mutex> lock(memLock);
+        replacement->onTick(frames);
+    }
     visualizeMemory(cycle);
 }
 
-void MemoryManager::visualizeMemory(int cycle) {
+// Paging view of memory as blocks: runs of adjacent frames that belong to the same process
+static std::vector<Block> frameRuns(size_t pageSize) {
+    std::vector<Block> runs;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        int pid = frames[i].pid;
+        if (!runs.empty() && runs.back().start + runs.back().size == i * pageSize &&
+            (runs.back().free ? pid < 0 : runs.back().process && runs.back().process->pid == pid)) {
+            runs.back().size += pageSize;
+            continue;
+        }
+        auto table = pageTables.find(pid);
+        runs.push_back({ i * pageSize, pageSize, pid < 0, table == pageTables.end() ? nullptr : table->second.process });
+    }
+    return runs;
+}
+
+// Copies the layout under the arena locks (or memLock when paging) so the caller can
+// format it without holding up allocations
+static std::vector<Block> layoutSnapshot(bool paging, size_t pageSize) {
+    if (!paging) return arenaLayout();
     std::lock_guard<std::mutex> lock(memLock);
+    return frameRuns(pageSize);
+}
+
+void MemoryManager::visualizeMemory(int cycle) {
+    std::vector<Block> layout = layoutSnapshot(paging, pageSize);
 
     std::ostringstream filename;
     filename << "memory_stamp_" << cycle << ".txt";
@@ -121,21 +376,15 @@ void MemoryManager::visualizeMemory(int cycle) {
 
     // Timestamp
     auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm tm;
-    localtime_s(&tm, &time_t);
+    std::tm tm = toLocalTime(std::chrono::system_clock::to_time_t(now));
     char timeBuffer[100];
     strftime(timeBuffer, sizeof(timeBuffer), "(%m/%d/%Y %I:%M:%S%p)", &tm);
 
-    int processesInMem = 0;
+    int processesInMem = getProcessesInMemory();
     size_t fragmentation = 0;
 
-    for (const auto& block : memoryBlocks) {
-        if (!block.free) processesInMem++;
-    }
-
     // Calculate external fragmentation (sum of all free blocks)
-    for (const auto& block : memoryBlocks) {
+    for (const auto& block : layout) {
         if (block.free) fragmentation += block.size;
     }
 
@@ -143,11 +392,11 @@ void MemoryManager::visualizeMemory(int cycle) {
     file << "Number of processes in memory: " << processesInMem << "\n";
     file << "Total external fragmentation in KB: " << fragmentation << "\n\n";
 
-    file << "----end---- = " << MEMORY_SIZE << "\n";
+    file << "----end---- = " << memorySize << "\n";
 
     // Print memory top-down
-    size_t current = MEMORY_SIZE;
-    for (auto it = memoryBlocks.rbegin(); it != memoryBlocks.rend(); ++it) {
+    size_t current = memorySize;
+    for (auto it = layout.rbegin(); it != layout.rend(); ++it) {
         size_t end = current;
         size_t start = it->start;
         if (!it->free && it->process) {
@@ -164,45 +413,347 @@ void MemoryManager::visualizeMemory(int cycle) {
 
 void MemoryManager::reset() {
     std::lock_guard<std::mutex> lock(memLock);
-    memoryBlocks.clear();
-    memoryBlocks.push_back({ 0, MEMORY_SIZE, true, nullptr });
+    for (size_t i = 0; i < tlbCount; ++i) tlbs[i].switchTo(-1);
+    configureMemory();
+    configureArenas();
+    configurePaging();
+    refreshStats();
 }
 
-size_t MemoryManager::getUsedMemory() const {
-    size_t used = 0;
-    for (const auto& block : memoryBlocks) {
-        if (!block.free) used += block.size;
+void MemoryManager::restoreLayout(const std::vector<std::shared_ptr<Process>>& processes) {
+    std::lock_guard<std::mutex> lock(memLock);
+    if (paging) {
+        // Every page starts out non-resident; writeRegion puts the saved contents in swap
+        for (const auto& process : processes) {
+            if (process->getBaseAddress() < 0) continue;
+            PageTable& table = pageTables[process->pid];
+            table.process = process;
+            table.frameOf.assign((process->getRequiredMemory() + pageSize - 1) / pageSize, -1);
+            process->setBaseAddress(0);
+        }
+        refreshStats();
+        return;
+    }
+
+    std::vector<std::shared_ptr<Process>> placed;
+    for (const auto& process : processes) {
+        if (process->getBaseAddress() >= 0) placed.push_back(process);
+    }
+    std::sort(placed.begin(), placed.end(), [](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+        return a->getBaseAddress() < b->getBaseAddress();
+        });
+
+    // Rebuilt arena by arena; a region that overlaps another or crosses an arena
+    // boundary (a checkpoint taken with a different arena count) is dropped
+    size_t next = 0;
+    for (size_t i = 0; i < arenaCount; ++i) {
+        Arena& arena = arenas[i];
+        std::lock_guard<std::mutex> arenaLock(arena.lock);
+        arena.blocks.clear();
+        size_t cursor = arena.start;
+        for (; next < placed.size() && static_cast<size_t>(placed[next]->getBaseAddress()) < arena.end; ++next) {
+            const auto& process = placed[next];
+            size_t base = static_cast<size_t>(process->getBaseAddress());
+            size_t size = process->getRequiredMemory();
+            if (base < cursor || size == 0 || base + size > arena.end) {
+                process->setBaseAddress(-1);
+                continue;
+            }
+            if (base > cursor) arena.blocks.push_back({ cursor, base - cursor, true, nullptr });
+            memory.clear(base, size);
+            arena.blocks.push_back({ base, size, false, process });
+            cursor = base + size;
+        }
+        if (cursor < arena.end) arena.blocks.push_back({ cursor, arena.end - cursor, true, nullptr });
+        arena.refresh();
     }
-    return used;
+    for (; next < placed.size(); ++next) placed[next]->setBaseAddress(-1);
 }
 
-size_t MemoryManager::getFreeMemory() const {
-    size_t freeMem = 0;
-    for (const auto& block : memoryBlocks) {
-        if (block.free) freeMem += block.size;
+// Virtual address -> physical index. A TLB miss walks the process's mapping: regions
+// are contiguous, so frame n of the process starts at base + n * pageSize. No lock is
+// needed because a process's base only changes while it is off every core.
+size_t MemoryManager::translate(const Process& process, int coreId, size_t address, bool write) {
+    int base = process.getBaseAddress();
+    size_t page = address / pageSize;
+    size_t frame;
+    if (paging) {
+        // Frames change owner on eviction, so a cached translation is only used while the
+        // frame still holds this page; reference and dirty bits are kept per access
+        int pid = process.pid;
+        auto holdsPage = [pid, page, this](size_t start) {
+            const Frame& owner = frames[start / pageSize];
+            return owner.pid == pid && owner.page == page;
+        };
+        bool cached = coreId >= 0 && static_cast<size_t>(coreId) < tlbCount && tlbs[coreId].lookup(page, frame, holdsPage);
+        if (!cached) {
+            frame = pageIn(process, page) * pageSize;
+            if (coreId >= 0 && static_cast<size_t>(coreId) < tlbCount) tlbs[coreId].insert(page, frame);
+        }
+        Frame& used = frames[frame / pageSize];
+        used.referenced = true;
+        if (write) used.dirty = true;
+        return frame + address % pageSize;
+    }
+
+    if (coreId < 0 || static_cast<size_t>(coreId) >= tlbCount) {
+        frame = static_cast<size_t>(base) + page * pageSize;
+    }
+    else if (!tlbs[coreId].lookup(page, frame)) {
+        frame = static_cast<size_t>(base) + page * pageSize;
+        tlbs[coreId].insert(page, frame);
     }
-    return freeMem;
+    return frame + address % pageSize;
 }
 
-size_t MemoryManager::getExternalFragmentation() const {
-    size_t frag = 0;
-    for (const auto& block : memoryBlocks) {
-        if (block.free) frag += block.size;
+// Page-fault path, memLock held. Returns the frame holding page, loading it from the
+// process's swap store (or zero-filling it) into a free frame or the policy's victim.
+size_t MemoryManager::pageIn(const Process& process, size_t page) {
+    auto found = pageTables.find(process.pid);
+    if (found == pageTables.end() || page >= found->second.frameOf.size()) throw AccessViolation(page * pageSize);
+    PageTable& table = found->second;
+    if (table.frameOf[page] >= 0) return static_cast<size_t>(table.frameOf[page]);
+
+    pageFaults.fetch_add(1, std::memory_order_relaxed);
+    table.process->pageFaults++;
+
+    size_t frame;
+    if (!freeFrames.empty()) {
+        frame = freeFrames.back();
+        freeFrames.pop_back();
+    }
+    else {
+        frame = replacement->chooseVictim(frames);
+        evict(frame);
+    }
+
+    auto saved = table.swapped.find(page);
+    memory.clear(frame * pageSize, pageSize);
+    if (saved != table.swapped.end()) std::copy(saved->second.begin(), saved->second.end(), memory.data() + frame * pageSize);
+
+    Frame& loaded = frames[frame];
+    loaded = Frame();
+    loaded.pid = process.pid;
+    loaded.page = page;
+    loaded.loadSeq = ++loadCounter;
+    table.frameOf[page] = static_cast<long>(frame);
+    replacement->onLoad(frames, frame);
+    refreshStats();
+    return frame;
+}
+
+// memLock held. A dirty page is copied to its owner's swap store; a clean one already
+// matches its swap copy (or is all zeros), so it is simply dropped.
+void MemoryManager::evict(size_t frame) {
+    Frame& victim = frames[frame];
+    PageTable& owner = pageTables[victim.pid];
+    if (victim.dirty) {
+        const char* start = memory.data() + frame * pageSize;
+        owner.swapped[victim.page].assign(start, start + pageSize);
+        pageWritebacks.fetch_add(1, std::memory_order_relaxed);
+        owner.process->pageWritebacks++;
+    }
+    owner.frameOf[victim.page] = -1;
+    pageEvictions.fetch_add(1, std::memory_order_relaxed);
+    owner.process->pageEvictions++;
+    victim = Frame();
+}
+
+void MemoryManager::checkAccess(const Process& process, size_t address) {
+    if (process.getBaseAddress() < 0 || address + 2 > process.getRequiredMemory()) {
+        accessViolations.fetch_add(1, std::memory_order_relaxed);
+        throw AccessViolation(address);
+    }
+}
+
+// Two single-byte translations so an access straddling a page boundary maps both pages
+uint16_t MemoryManager::read(const Process& process, int coreId, size_t address) {
+    checkAccess(process, address);
+    // Contiguous regions never move while their process runs; frames can, so paging locks
+    std::unique_lock<std::mutex> lock(memLock, std::defer_lock);
+    if (paging) lock.lock();
+    size_t low = translate(process, coreId, address, false);
+    size_t high = translate(process, coreId, address + 1, false);
+    return static_cast<uint16_t>(static_cast<unsigned char>(memory[low]) |
+        (static_cast<unsigned char>(memory[high]) << 8));
+}
+
+void MemoryManager::write(const Process& process, int coreId, size_t address, uint16_t value) {
+    checkAccess(process, address);
+    std::unique_lock<std::mutex> lock(memLock, std::defer_lock);
+    if (paging) lock.lock();
+    size_t low = translate(process, coreId, address, true);
+    size_t high = translate(process, coreId, address + 1, true);
+    memory[low] = static_cast<char>(value & 0xFF);
+    memory[high] = static_cast<char>(value >> 8);
+}
+
+void MemoryManager::switchContext(int coreId, int pid) {
+    if (coreId >= 0 && static_cast<size_t>(coreId) < tlbCount) tlbs[coreId].switchTo(pid);
+}
+
+void MemoryManager::getTlbTotals(uint64_t& hits, uint64_t& misses, uint64_t& flushes) const {
+    hits = misses = flushes = 0;
+    for (size_t i = 0; i < tlbCount; ++i) {
+        hits += tlbs[i].getHits();
+        misses += tlbs[i].getMisses();
+        flushes += tlbs[i].getFlushes();
     }
-    return frag;
+}
+
+std::vector<char> MemoryManager::readRegion(const Process& process) const {
+    int base = process.getBaseAddress();
+    if (base < 0) return {};
+    if (paging) {
+        std::lock_guard<std::mutex> lock(memLock);
+        auto found = pageTables.find(process.pid);
+        if (found == pageTables.end()) return {};
+        const PageTable& table = found->second;
+        std::vector<char> bytes(table.frameOf.size() * pageSize, 0);
+        for (size_t page = 0; page < table.frameOf.size(); ++page) {
+            auto out = bytes.begin() + page * pageSize;
+            auto saved = table.swapped.find(page);
+            if (table.frameOf[page] >= 0) {
+                const char* start = memory.data() + table.frameOf[page] * pageSize;
+                std::copy(start, start + pageSize, out);
+            }
+            else if (saved != table.swapped.end()) std::copy(saved->second.begin(), saved->second.end(), out);
+        }
+        bytes.resize(std::min(bytes.size(), process.getRequiredMemory()));
+        while (!bytes.empty() && bytes.back() == 0) bytes.pop_back();
+        return bytes;
+    }
+    size_t size = std::min(process.getRequiredMemory(), memorySize - static_cast<size_t>(base));
+    const char* first = memory.data() + base;
+    while (size > 0 && first[size - 1] == 0) --size;
+    return std::vector<char>(first, first + size);
+}
+
+void MemoryManager::writeRegion(const Process& process, const std::vector<char>& bytes) {
+    int base = process.getBaseAddress();
+    if (base < 0) return;
+    if (paging) {
+        std::lock_guard<std::mutex> lock(memLock);
+        auto found = pageTables.find(process.pid);
+        if (found == pageTables.end()) return;
+        size_t size = std::min(bytes.size(), found->second.frameOf.size() * pageSize);
+        for (size_t start = 0; start < size; start += pageSize) {
+            std::vector<char>& page = found->second.swapped[start / pageSize];
+            page.assign(pageSize, 0);
+            std::copy(bytes.begin() + start, bytes.begin() + std::min(start + pageSize, size), page.begin());
+        }
+        return;
+    }
+    size_t size = std::min({ bytes.size(), process.getRequiredMemory(), memorySize - static_cast<size_t>(base) });
+    memory.clear(base, size);
+    std::copy(bytes.begin(), bytes.begin() + size, memory.data() + base);
+}
+
+// Paging gauges, called with memLock held after every frame change; contiguous mode
+// keeps its gauges per arena (Arena::refresh)
+void MemoryManager::refreshStats() {
+    size_t freeTotal = freeFrames.size() * pageSize;
+    usedBytes.store(frames.size() * pageSize - freeTotal, std::memory_order_relaxed);
+    freeBytes.store(freeTotal, std::memory_order_relaxed);
+    freeBlocks.store(freeFrames.size(), std::memory_order_relaxed);
+    largestFreeBlock.store(freeFrames.empty() ? 0 : pageSize, std::memory_order_relaxed);
+}
+
+void MemoryManager::writeMetrics(std::ostream& out) const {
+    out << "# HELP csopesy_memory_allocations_total Successful memory allocations.\n";
+    out << "# TYPE csopesy_memory_allocations_total counter\n";
+    out << "csopesy_memory_allocations_total " << getAllocations() << "\n";
+    out << "# HELP csopesy_memory_allocation_failures_total Allocation attempts that found no free block.\n";
+    out << "# TYPE csopesy_memory_allocation_failures_total counter\n";
+    out << "csopesy_memory_allocation_failures_total " << allocationFailures.load() << "\n";
+    out << "# HELP csopesy_memory_frees_total Blocks returned to the allocator.\n";
+    out << "# TYPE csopesy_memory_frees_total counter\n";
+    out << "csopesy_memory_frees_total " << getFrees() << "\n";
+    out << "# HELP csopesy_memory_used_bytes Bytes allocated to processes.\n";
+    out << "# TYPE csopesy_memory_used_bytes gauge\n";
+    out << "csopesy_memory_used_bytes " << getUsedMemory() << "\n";
+    out << "# HELP csopesy_memory_external_fragmentation_bytes Total bytes in free blocks.\n";
+    out << "# TYPE csopesy_memory_external_fragmentation_bytes gauge\n";
+    out << "csopesy_memory_external_fragmentation_bytes " << getFreeBytes() << "\n";
+    out << "# HELP csopesy_memory_free_blocks Number of free blocks.\n";
+    out << "# TYPE csopesy_memory_free_blocks gauge\n";
+    out << "csopesy_memory_free_blocks " << (paging ? freeBlocks.load() : sumArenas().freeBlocks) << "\n";
+    out << "# HELP csopesy_memory_largest_free_block_bytes Largest contiguous free block.\n";
+    out << "# TYPE csopesy_memory_largest_free_block_bytes gauge\n";
+    out << "csopesy_memory_largest_free_block_bytes " << (paging ? largestFreeBlock.load() : sumArenas().largest) << "\n";
+    out << "# HELP csopesy_memory_committed_bytes Bytes of emulated memory touched so far (backed by the host).\n";
+    out << "# TYPE csopesy_memory_committed_bytes gauge\n";
+    out << "csopesy_memory_committed_bytes " << getCommittedBytes() << "\n";
+    out << "# HELP csopesy_memory_arena_used_bytes Bytes allocated to processes in each arena.\n";
+    out << "# TYPE csopesy_memory_arena_used_bytes gauge\n";
+    for (size_t i = 0; i < (paging ? 0 : arenaCount); ++i) {
+        out << "csopesy_memory_arena_used_bytes{arena=\"" << i << "\"} " << arenas[i].used.load(std::memory_order_relaxed) << "\n";
+    }
+    out << "# HELP csopesy_memory_arena_steals_total Allocations served from another core's arena.\n";
+    out << "# TYPE csopesy_memory_arena_steals_total counter\n";
+    out << "csopesy_memory_arena_steals_total " << arenaSteals.load() << "\n";
+    out << "# HELP csopesy_memory_access_violations_total READ/WRITE accesses outside the process's region.\n";
+    out << "# TYPE csopesy_memory_access_violations_total counter\n";
+    out << "csopesy_memory_access_violations_total " << accessViolations.load() << "\n";
+    out << "# HELP csopesy_page_faults_total Pages loaded on first touch or after eviction.\n";
+    out << "# TYPE csopesy_page_faults_total counter\n";
+    out << "csopesy_page_faults_total " << pageFaults.load() << "\n";
+    out << "# HELP csopesy_page_evictions_total Pages removed from a frame by the replacement policy.\n";
+    out << "# TYPE csopesy_page_evictions_total counter\n";
+    out << "csopesy_page_evictions_total " << pageEvictions.load() << "\n";
+    out << "# HELP csopesy_page_writebacks_total Dirty pages copied to swap on eviction.\n";
+    out << "# TYPE csopesy_page_writebacks_total counter\n";
+    out << "csopesy_page_writebacks_total " << pageWritebacks.load() << "\n";
+}
+
+size_t MemoryManager::getUsedMemory() const {
+    if (paging) return usedBytes.load();
+    return sumArenas().used;
+}
+
+size_t MemoryManager::getFreeMemory() const {
+    return getFreeBytes();
+}
+
+size_t MemoryManager::getFreeBytes() const {
+    if (paging) return freeBytes.load();
+    return sumArenas().freeTotal;
+}
+
+// Arena counters are summed over every slot so totals survive a reset to fewer arenas
+uint64_t MemoryManager::getAllocations() const {
+    uint64_t total = allocations.load();
+    for (int i = 0; i < MAX_CORES; ++i) total += arenas[i].allocations.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t MemoryManager::getFrees() const {
+    uint64_t total = frees.load();
+    for (int i = 0; i < MAX_CORES; ++i) total += arenas[i].frees.load(std::memory_order_relaxed);
+    return total;
+}
+
+size_t MemoryManager::getArenaCount() const {
+    return paging ? 0 : arenaCount;
+}
+
+// Paging has no external fragmentation: any free frame can hold any page
+size_t MemoryManager::getExternalFragmentation() const {
+    if (paging) return 0;
+    return sumArenas().freeTotal;
 }
 
 int MemoryManager::getProcessesInMemory() const {
-    int count = 0;
-    for (const auto& block : memoryBlocks) {
-        if (!block.free) count++;
+    if (paging) {
+        std::lock_guard<std::mutex> lock(memLock);
+        return static_cast<int>(pageTables.size());
     }
-    return count;
+    return sumArenas().processes;
 }
 
 void MemoryManager::printMemoryStatus() const {
     std::cout << "\n=== Memory Layout ===\n";
-    for (const auto& block : memoryBlocks) {
+    for (const auto& block : layoutSnapshot(paging, pageSize)) {
         std::cout << "[" << block.start << "-" << (block.start + block.size - 1)
             << "] " << (block.free ? "FREE" : "USED");
         if (!block.free && block.process) {
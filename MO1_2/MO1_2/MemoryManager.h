@@ -6,20 +6,61 @@
 #include <memory>
 #include <string>
 #include <atomic>
+#include <mutex>
+#include <ostream>
+#include <cstdint>
+#include <stdexcept>
+#include "Tlb.h"
+#include "PhysicalMemory.h"
 
 // ✅ Forward declare to avoid cyclic include
 struct Process;
+struct Arena;
+
+// Thrown by READ/WRITE when an access falls outside the process's allocated region
+class AccessViolation : public std::runtime_error {
+public:
+    explicit AccessViolation(size_t address);
+    size_t getAddress() const { return address; }
+
+private:
+    size_t address;
+};
 
 class MemoryManager {
 private:
-    static constexpr size_t MEMORY_SIZE = 16384;
+    // Used when max-overall-mem is 0 or the host will not map the requested size
+    static constexpr size_t DEFAULT_MEMORY_SIZE = 16384;
     static std::unique_ptr<MemoryManager> instance;
     static std::once_flag initFlag;
 
-    std::vector<char> memory;
+    PhysicalMemory memory;
+    size_t memorySize = 0;  // max-overall-mem, fixed until the next reset()
     mutable std::shared_mutex memoryMutex;
     std::atomic<int> currentCycle{ 0 };
 
+    // Counters read lock-free by the metrics exporter. Contiguous mode counts allocations,
+    // frees and its gauges per arena and sums them; these cover paging, where the gauges
+    // are refreshed under memLock
+    std::atomic<uint64_t> allocations{ 0 };
+    std::atomic<uint64_t> allocationFailures{ 0 };
+    std::atomic<uint64_t> frees{ 0 };
+    std::atomic<uint64_t> arenaSteals{ 0 };
+    std::atomic<size_t> usedBytes{ 0 };
+    std::atomic<size_t> freeBytes{ 0 };
+    std::atomic<size_t> freeBlocks{ 0 };
+    std::atomic<size_t> largestFreeBlock{ 0 };
+    std::atomic<uint64_t> accessViolations{ 0 };
+
+    // One TLB per emulated core; pages are mem-per-frame bytes of a process's region
+    std::unique_ptr<SoftwareTlb[]> tlbs;
+    size_t tlbCount = 0;
+    size_t pageSize = 16;
+    bool paging = false;  // page-replacement set: demand paging instead of contiguous blocks
+    std::atomic<uint64_t> pageFaults{ 0 };
+    std::atomic<uint64_t> pageEvictions{ 0 };
+    std::atomic<uint64_t> pageWritebacks{ 0 };
+
     // Constructor
     MemoryManager();
 
@@ -27,17 +68,50 @@ private:
     bool canAllocateAt(size_t startIndex, size_t size) const;
     void allocateAt(size_t startIndex, size_t size);
     std::string getCurrentTimestamp() const;
+    void refreshStats();
+    void configureMemory();
+    void configureArenas();
+    void configurePaging();
+    bool allocateIn(Arena& arena, std::shared_ptr<Process> process, int coreId);
+    void checkAccess(const Process& process, size_t address);
+    size_t translate(const Process& process, int coreId, size_t address, bool write);
+    size_t pageIn(const Process& process, size_t page);
+    void evict(size_t frame);
 
 public:
     // Singleton accessor
     static MemoryManager& getInstance();
 
     // Memory ops
-    bool allocate(std::shared_ptr<Process> process);
-    void deallocate(std::shared_ptr<Process> process);
+    bool allocate(std::shared_ptr<Process> process, int coreId = -1);
+    void deallocate(std::shared_ptr<Process> process, int coreId = -1);
     void visualizeMemory(int cycle);
     void incrementCycle();
+    // Drops every allocation, re-reads max-overall-mem and the paging settings, and hands
+    // touched pages back to the host
     void reset();
+    // Rebuilds the block list from restored processes' base addresses; overlapping or
+    // out-of-range placements are dropped and those processes allocate again on dispatch
+    void restoreLayout(const std::vector<std::shared_ptr<Process>>& processes);
+    void setCycle(int cycle) { currentCycle = cycle; }
+
+    // Emulated loads and stores of 16-bit values at an offset in the process's region,
+    // translated through the core's TLB. Throw AccessViolation if [address, address + 2)
+    // is outside the region or the process holds no memory.
+    uint16_t read(const Process& process, int coreId, size_t address);
+    void write(const Process& process, int coreId, size_t address, uint16_t value);
+    // Called on every dispatch; flushes the core's TLB when the process changes
+    void switchContext(int coreId, int pid);
+    const SoftwareTlb& getTlb(int coreId) const { return tlbs[coreId]; }
+    void getTlbTotals(uint64_t& hits, uint64_t& misses, uint64_t& flushes) const;
+    uint64_t getAccessViolations() const { return accessViolations.load(); }
+    bool isPaging() const { return paging; }
+    uint64_t getPageFaults() const { return pageFaults.load(); }
+    uint64_t getPageEvictions() const { return pageEvictions.load(); }
+    uint64_t getPageWritebacks() const { return pageWritebacks.load(); }
+    // Copies of a process's region for checkpoints; trailing zero bytes are left out
+    std::vector<char> readRegion(const Process& process) const;
+    void writeRegion(const Process& process, const std::vector<char>& bytes);
 
     // Stats
     size_t getUsedMemory() const;
@@ -45,8 +119,18 @@ public:
     size_t getExternalFragmentation() const;
     int getProcessesInMemory() const;
     void printMemoryStatus() const;
+    void writeMetrics(std::ostream& out) const;
 
-    size_t getTotalMemory() const { return MEMORY_SIZE; }
+    size_t getTotalMemory() const { return memorySize; }
+    // Bytes of the mapping that have ever been handed out, i.e. what the host may have backed
+    size_t getCommittedBytes() const { return memory.touchedBytes(); }
+    size_t getFreeBytes() const;
+    size_t getArenaCount() const;
+    // Allocations a core satisfied from another core's arena because its own was full
+    uint64_t getArenaSteals() const { return arenaSteals.load(); }
+    uint64_t getAllocations() const;
+    uint64_t getFrees() const;
+    uint64_t getAllocationFailures() const { return allocationFailures.load(); }
 
     // Disable copy/move
     MemoryManager(const MemoryManager&) = delete;
@@ -0,0 +1,123 @@
+#include "MetricsExporter.h"
+#include "scheduler.h"
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+typedef SOCKET socket_t;
+static const socket_t INVALID_SOCK = INVALID_SOCKET;
+static const int SEND_FLAGS = 0;
+static void closeSocket(socket_t s) { closesocket(s); }
+static int pollOne(socket_t s, int timeoutMs) {
+    WSAPOLLFD pfd{ s, POLLRDNORM, 0 };
+    return WSAPoll(&pfd, 1, timeoutMs);
+}
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+typedef int socket_t;
+static const socket_t INVALID_SOCK = -1;
+static const int SEND_FLAGS = MSG_NOSIGNAL;  // a scraper hanging up must not kill the emulator
+static void closeSocket(socket_t s) { close(s); }
+static int pollOne(socket_t s, int timeoutMs) {
+    pollfd pfd{ s, POLLIN, 0 };
+    return poll(&pfd, 1, timeoutMs);
+}
+#endif
+
+MetricsExporter& MetricsExporter::getInstance() {
+    static MetricsExporter instance;
+    return instance;
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(const std::string& path) {
+    if (serving.load()) return false;
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return false;
+#endif
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) return false;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    socket_t listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCK) return false;
+
+    std::remove(path.c_str());  // stale socket from a previous run
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener, 8) != 0) {
+        closeSocket(listener);
+        return false;
+    }
+
+    socketPath = path;
+    serving = true;
+    serverThread = std::thread(&MetricsExporter::serve, this, static_cast<long long>(listener));
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!serving.load()) return;
+    serving = false;
+    if (serverThread.joinable()) serverThread.join();
+    std::remove(socketPath.c_str());
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void MetricsExporter::serve(long long listenSocket) {
+    socket_t listener = static_cast<socket_t>(listenSocket);
+
+    while (serving.load()) {
+        // Poll with a timeout so stop() is noticed without closing the socket under accept()
+        if (pollOne(listener, 200) <= 0) continue;
+
+        socket_t client = accept(listener, nullptr, nullptr);
+        if (client == INVALID_SOCK) continue;
+
+        // Give HTTP clients a moment to send their request line
+        char request[512];
+        int received = 0;
+        if (pollOne(client, 100) > 0) {
+            received = static_cast<int>(recv(client, request, sizeof(request), 0));
+        }
+        bool http = received >= 3 && std::strncmp(request, "GET", 3) == 0;
+
+        std::ostringstream body;
+        writeMetrics(body);
+        std::string payload = body.str();
+
+        std::string response;
+        if (http) {
+            response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                std::to_string(payload.size()) + "\r\n\r\n" + payload;
+        }
+        else {
+            response = payload;
+        }
+
+        size_t sent = 0;
+        while (sent < response.size()) {
+            int n = static_cast<int>(send(client, response.data() + sent, static_cast<int>(response.size() - sent), SEND_FLAGS));
+            if (n <= 0) break;
+            sent += static_cast<size_t>(n);
+        }
+        closeSocket(client);
+    }
+
+    closeSocket(listener);
+}
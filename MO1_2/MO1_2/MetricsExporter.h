@@ -0,0 +1,34 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include <string>
+#include <thread>
+#include <atomic>
+
+// Serves the scheduler and memory metrics in Prometheus text format on a UNIX
+// domain socket. A client sending an HTTP GET gets an HTTP response; any other
+// client (e.g. socat) just receives the exposition text.
+class MetricsExporter {
+private:
+    MetricsExporter() = default;
+
+    std::string socketPath;
+    std::thread serverThread;
+    std::atomic<bool> serving{ false };
+
+    void serve(long long listenSocket);
+
+public:
+    static MetricsExporter& getInstance();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+    ~MetricsExporter();
+
+    bool start(const std::string& path);
+    void stop();
+    bool isServing() const { return serving.load(); }
+    const std::string& getSocketPath() const { return socketPath; }
+};
+
+#endif // METRICS_EXPORTER_H
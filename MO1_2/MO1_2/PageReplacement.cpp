@@ -0,0 +1,85 @@
+#include "PageReplacement.h"
+#include <algorithm>
+
+bool FifoPolicy::isCurrent(const std::vector<Frame>& frames, const std::pair<size_t, uint64_t>& entry) const {
+    const Frame& frame = frames[entry.first];
+    return frame.pid >= 0 && frame.loadSeq == entry.second;
+}
+
+void FifoPolicy::onLoad(std::vector<Frame>& frames, size_t frame) {
+    order.emplace_back(frame, frames[frame].loadSeq);
+    // Frames freed without eviction leave stale entries; drop them before the queue grows unbounded
+    if (order.size() > 2 * frames.size()) {
+        order.erase(std::remove_if(order.begin(), order.end(),
+            [&](const std::pair<size_t, uint64_t>& entry) { return !isCurrent(frames, entry); }), order.end());
+    }
+}
+
+size_t FifoPolicy::chooseVictim(std::vector<Frame>& frames) {
+    while (true) {
+        auto entry = order.front();
+        order.pop_front();
+        if (isCurrent(frames, entry)) return entry.first;
+    }
+}
+
+size_t SecondChancePolicy::chooseVictim(std::vector<Frame>& frames) {
+    while (true) {
+        auto entry = order.front();
+        order.pop_front();
+        if (!isCurrent(frames, entry)) continue;
+        Frame& frame = frames[entry.first];
+        if (!frame.referenced) return entry.first;
+        frame.referenced = false;
+        order.push_back(entry);
+    }
+}
+
+size_t ClockPolicy::chooseVictim(std::vector<Frame>& frames) {
+    while (true) {
+        size_t current = hand;
+        hand = (hand + 1) % frames.size();
+        Frame& frame = frames[current];
+        if (frame.pid < 0) continue;
+        if (!frame.referenced) return current;
+        frame.referenced = false;
+    }
+}
+
+void AgingLruPolicy::onLoad(std::vector<Frame>& frames, size_t frame) {
+    frames[frame].age = 0;
+}
+
+void AgingLruPolicy::onTick(std::vector<Frame>& frames) {
+    for (auto& frame : frames) {
+        if (frame.pid < 0) continue;
+        frame.age = static_cast<uint8_t>((frame.age >> 1) | (frame.referenced ? 0x80 : 0));
+        frame.referenced = false;
+    }
+}
+
+size_t AgingLruPolicy::chooseVictim(std::vector<Frame>& frames) {
+    size_t victim = 0;
+    unsigned best = ~0u;
+    uint64_t bestSeq = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const Frame& frame = frames[i];
+        if (frame.pid < 0) continue;
+        unsigned key = (frame.referenced ? 0x100u : 0u) | frame.age;
+        // Ties go to the page loaded first
+        if (key < best || (key == best && frame.loadSeq < bestSeq)) {
+            victim = i;
+            best = key;
+            bestSeq = frame.loadSeq;
+        }
+    }
+    return victim;
+}
+
+std::unique_ptr<ReplacementPolicy> makeReplacementPolicy(const std::string& name) {
+    if (name == "fifo") return std::unique_ptr<ReplacementPolicy>(new FifoPolicy());
+    if (name == "lru") return std::unique_ptr<ReplacementPolicy>(new AgingLruPolicy());
+    if (name == "clock") return std::unique_ptr<ReplacementPolicy>(new ClockPolicy());
+    if (name == "second-chance") return std::unique_ptr<ReplacementPolicy>(new SecondChancePolicy());
+    return nullptr;
+}
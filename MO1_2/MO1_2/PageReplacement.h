@@ -0,0 +1,76 @@
+#ifndef PAGE_REPLACEMENT_H
+#define PAGE_REPLACEMENT_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// One physical frame under demand paging; pid < 0 means the frame is free.
+// referenced/dirty are set by every READ/WRITE that touches the page.
+struct Frame {
+    int pid = -1;
+    size_t page = 0;
+    bool referenced = false;
+    bool dirty = false;
+    uint8_t age = 0;        // lru: aging counter, shifted once per tick
+    uint64_t loadSeq = 0;   // order the frame's current page was loaded in
+};
+
+// Victim selection for a full frame table. MemoryManager calls every hook with memLock
+// held; chooseVictim is only called when no frame is free.
+class ReplacementPolicy {
+public:
+    virtual ~ReplacementPolicy() = default;
+    virtual const char* getName() const = 0;
+    virtual void onLoad(std::vector<Frame>&, size_t) {}
+    virtual void onTick(std::vector<Frame>&) {}
+    virtual size_t chooseVictim(std::vector<Frame>& frames) = 0;
+};
+
+// Oldest loaded page goes first, regardless of use
+class FifoPolicy : public ReplacementPolicy {
+public:
+    const char* getName() const override { return "fifo"; }
+    void onLoad(std::vector<Frame>& frames, size_t frame) override;
+    size_t chooseVictim(std::vector<Frame>& frames) override;
+
+protected:
+    // (frame, loadSeq); entries whose frame was freed or reloaded since are skipped
+    std::deque<std::pair<size_t, uint64_t>> order;
+    bool isCurrent(const std::vector<Frame>& frames, const std::pair<size_t, uint64_t>& entry) const;
+};
+
+// FIFO order, but a referenced page has its bit cleared and goes to the back of the queue
+class SecondChancePolicy : public FifoPolicy {
+public:
+    const char* getName() const override { return "second-chance"; }
+    size_t chooseVictim(std::vector<Frame>& frames) override;
+};
+
+// A hand sweeps the frames in physical order, clearing reference bits until it finds a clear one
+class ClockPolicy : public ReplacementPolicy {
+public:
+    const char* getName() const override { return "clock"; }
+    size_t chooseVictim(std::vector<Frame>& frames) override;
+
+private:
+    size_t hand = 0;
+};
+
+// LRU approximated by aging: every tick each frame's 8-bit age shifts right and takes
+// the reference bit as its top bit. The frame with the lowest (reference bit, age) goes.
+class AgingLruPolicy : public ReplacementPolicy {
+public:
+    const char* getName() const override { return "lru"; }
+    void onLoad(std::vector<Frame>& frames, size_t frame) override;
+    void onTick(std::vector<Frame>& frames) override;
+    size_t chooseVictim(std::vector<Frame>& frames) override;
+};
+
+// fifo | lru | clock | second-chance; null for anything else
+std::unique_ptr<ReplacementPolicy> makeReplacementPolicy(const std::string& name);
+
+#endif // PAGE_REPLACEMENT_H
@@ -0,0 +1,82 @@
+#include "PhysicalMemory.h"
+#include <algorithm>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+PhysicalMemory::~PhysicalMemory() {
+    release();
+}
+
+bool PhysicalMemory::reserve(size_t size) {
+    release();
+    if (size == 0) return false;
+#ifdef _WIN32
+    // Committed pages are charged to the pagefile but only get RAM on first touch
+    void* mapped = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!mapped) return false;
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (mapped == MAP_FAILED) return false;
+#endif
+    base = static_cast<char*>(mapped);
+    length = size;
+    granuleWords = ((size + GRANULE - 1) / GRANULE + 63) / 64;
+    touchedGranules.reset(new std::atomic<uint64_t>[granuleWords]);
+    for (size_t i = 0; i < granuleWords; ++i) touchedGranules[i].store(0, std::memory_order_relaxed);
+    touched = 0;
+    return true;
+}
+
+void PhysicalMemory::discard() {
+    if (!base || touched == 0) return;
+#if defined(_WIN32)
+    VirtualFree(base, length, MEM_DECOMMIT);
+    VirtualAlloc(base, length, MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__linux__)
+    // Private anonymous pages read back as zero after MADV_DONTNEED
+    madvise(base, length, MADV_DONTNEED);
+#else
+    std::memset(base, 0, length);
+#endif
+    for (size_t i = 0; i < granuleWords; ++i) touchedGranules[i].store(0, std::memory_order_relaxed);
+    touched = 0;
+}
+
+// A granule seen for the first time is still all zeros from the mapping, so only
+// granules some earlier clear() already marked need writing
+void PhysicalMemory::clear(size_t start, size_t size) {
+    size_t end = std::min(start + size, length);
+    for (size_t granule = start / GRANULE; granule * GRANULE < end; ++granule) {
+        size_t from = std::max(start, granule * GRANULE);
+        size_t to = std::min(end, (granule + 1) * GRANULE);
+        uint64_t bit = uint64_t{ 1 } << (granule % 64);
+        if (touchedGranules[granule / 64].fetch_or(bit, std::memory_order_relaxed) & bit) {
+            std::memset(base + from, 0, to - from);
+        }
+        else {
+            touched.fetch_add(std::min(GRANULE, length - granule * GRANULE), std::memory_order_relaxed);
+        }
+    }
+}
+
+void PhysicalMemory::release() {
+    if (!base) return;
+#ifdef _WIN32
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, length);
+#endif
+    base = nullptr;
+    length = 0;
+    touchedGranules.reset();
+    granuleWords = 0;
+    touched = 0;
+}
@@ -0,0 +1,48 @@
+#ifndef PHYSICAL_MEMORY_H
+#define PHYSICAL_MEMORY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Emulated physical memory: one anonymous mapping reserved at its full size up front
+// (mmap on POSIX, VirtualAlloc on Windows). The host only backs a page once it is
+// touched, so a large max-overall-mem costs address space rather than RAM until
+// processes actually use it. Every range handed to a process must go through clear(),
+// which keeps a bitmap of touched 4KB granules so untouched pages are never written
+// just to zero them. clear() may run concurrently on disjoint ranges.
+class PhysicalMemory {
+public:
+    PhysicalMemory() = default;
+    ~PhysicalMemory();
+
+    // Replaces any previous mapping with size zero-filled bytes; false if the host refuses
+    bool reserve(size_t size);
+    // Hands every touched page back to the host; all of memory reads as zero again
+    void discard();
+    // Zeroes [start, start + length) and marks it touched
+    void clear(size_t start, size_t length);
+
+    static constexpr size_t GRANULE = 4096;
+    char* data() { return base; }
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+    size_t touchedBytes() const { return touched.load(std::memory_order_relaxed); }
+    char& operator[](size_t index) { return base[index]; }
+    const char& operator[](size_t index) const { return base[index]; }
+
+    PhysicalMemory(const PhysicalMemory&) = delete;
+    PhysicalMemory& operator=(const PhysicalMemory&) = delete;
+
+private:
+    void release();
+
+    char* base = nullptr;
+    size_t length = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> touchedGranules;  // one bit per GRANULE bytes
+    size_t granuleWords = 0;
+    std::atomic<size_t> touched{ 0 };
+};
+
+#endif // PHYSICAL_MEMORY_H
@@ -1,4 +1,5 @@
 ﻿#include "PrintInstruction.h"
+#include "Checkpoint.h"
 #include "process.h"
 #include "utils.h"
 #include <sstream>
@@ -30,3 +31,15 @@ void PrintInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
     proc->logs.push_back(logEntry.str());
     logToFile(proc->name, logEntry.str(), coreId);
 }
+
+void PrintInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::PRINT));
+    out.putString(message);
+    out.putString(variableName);
+    out.putU8(hasVariable ? 1 : 0);
+    out.putString(logPrefix);
+}
+
+Opcode PrintInstruction::opcode() const {
+    return Opcode::PRINT;
+}
@@ -1,7 +1,7 @@
 #ifndef PRINTINSTRUCTION_H
 #define PRINTINSTRUCTION_H
 
-#include "instruction.h"
+#include "Instruction.h"
 #include <string>
 #include <memory>
 
@@ -27,6 +27,8 @@ public:
     //PrintInstruction(const std::string& textPart, const std::string& varName, const std::string& logPrefix = "");
 
     void execute(std::shared_ptr<Process> proc, int coreId = -1) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
 
     std::string getMessage() const { return message; }
     std::string getVariableName() const { return variableName; }
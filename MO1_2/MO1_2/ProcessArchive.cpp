@@ -0,0 +1,198 @@
+#include "ProcessArchive.h"
+#include "config.h"
+#include <sstream>
+#include <cstring>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    // Stream of tokens: 0x00-0x7F = literal run of (byte + 1) bytes,
+    // 0x80-0xFF = copy (byte & 0x7F) + 4 bytes from u16 distance back
+    const size_t MIN_MATCH = 4;
+    const size_t MAX_MATCH = 0x7F + MIN_MATCH;
+    const size_t MAX_LITERALS = 0x80;
+    const size_t MAX_DISTANCE = 0xFFFF;
+
+    std::string compress(const std::string& in) {
+        std::string out;
+        out.reserve(in.size() / 2);
+        std::vector<int64_t> table(1 << 12, -1);
+        size_t pos = 0, literalStart = 0;
+
+        auto flushLiterals = [&](size_t end) {
+            while (literalStart < end) {
+                size_t run = std::min(end - literalStart, MAX_LITERALS);
+                out.push_back(static_cast<char>(run - 1));
+                out.append(in, literalStart, run);
+                literalStart += run;
+            }
+        };
+
+        while (pos + MIN_MATCH <= in.size()) {
+            uint32_t key;
+            std::memcpy(&key, in.data() + pos, sizeof(key));
+            size_t slot = (key * 2654435761u) >> 20;
+            int64_t candidate = table[slot];
+            table[slot] = static_cast<int64_t>(pos);
+
+            if (candidate < 0 || pos - candidate > MAX_DISTANCE ||
+                std::memcmp(in.data() + candidate, in.data() + pos, MIN_MATCH) != 0) {
+                pos++;
+                continue;
+            }
+
+            size_t length = MIN_MATCH;
+            while (length < MAX_MATCH && pos + length < in.size() && in[candidate + length] == in[pos + length]) length++;
+            flushLiterals(pos);
+            size_t distance = pos - static_cast<size_t>(candidate);
+            out.push_back(static_cast<char>(0x80 | (length - MIN_MATCH)));
+            out.push_back(static_cast<char>(distance & 0xFF));
+            out.push_back(static_cast<char>(distance >> 8));
+            pos += length;
+            literalStart = pos;
+        }
+        flushLiterals(in.size());
+        return out;
+    }
+
+    bool decompress(const std::string& in, size_t rawSize, std::string& out) {
+        out.clear();
+        out.reserve(rawSize);
+        size_t pos = 0;
+        while (pos < in.size()) {
+            uint8_t token = static_cast<uint8_t>(in[pos++]);
+            if (token < 0x80) {
+                size_t run = token + 1u;
+                if (pos + run > in.size()) return false;
+                out.append(in, pos, run);
+                pos += run;
+                continue;
+            }
+            if (pos + 2 > in.size()) return false;
+            size_t length = (token & 0x7F) + MIN_MATCH;
+            size_t distance = static_cast<uint8_t>(in[pos]) | (static_cast<uint8_t>(in[pos + 1]) << 8);
+            pos += 2;
+            if (distance == 0 || distance > out.size()) return false;
+            size_t from = out.size() - distance;
+            for (size_t i = 0; i < length; ++i) {
+                char ch = out[from + i];
+                out.push_back(ch);
+            }
+        }
+        return out.size() == rawSize;
+    }
+}
+
+ProcessArchive& ProcessArchive::getInstance() {
+    static ProcessArchive instance;
+    return instance;
+}
+
+bool ProcessArchive::archive(const Process& proc) {
+    std::ostringstream logText;
+    proc.logs.writeAll(logText);
+    std::string raw = logText.str();
+    std::string packed = compress(raw);
+
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    if (byName.count(proc.name)) return true;
+    if (!out.is_open()) {
+        path = Config::getInstance().archiveFile;
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        writeOffset = 0;
+    }
+    out.write(packed.data(), static_cast<std::streamsize>(packed.size()));
+    out.flush();
+    if (!out) return false;
+
+    ArchivedProcess record;
+    record.name = proc.name;
+    record.pid = proc.pid;
+    record.arrivalTime = proc.arrivalTime;
+    record.startTime = proc.startTime;
+    record.endTime = proc.endTime;
+    record.totalInstructions = proc.totalInstructions;
+    record.completedInstructions = proc.completedInstructions->load();
+    record.offset = writeOffset;
+    record.rawSize = static_cast<uint32_t>(raw.size());
+    record.packedSize = static_cast<uint32_t>(packed.size());
+
+    writeOffset += packed.size();
+    rawBytes += raw.size();
+    byName[record.name] = records.size();
+    records.push_back(std::move(record));
+    return true;
+}
+
+bool ProcessArchive::contains(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    return byName.count(name) > 0;
+}
+
+std::shared_ptr<Process> ProcessArchive::restore(const std::string& name) const {
+    ArchivedProcess record;
+    std::string file;
+    {
+        std::lock_guard<std::mutex> lock(archiveMutex);
+        auto it = byName.find(name);
+        if (it == byName.end()) return nullptr;
+        record = records[it->second];
+        file = path;
+    }
+
+    std::string packed(record.packedSize, '\0'), raw;
+    std::ifstream in(file, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(record.offset));
+    if (!in.read(&packed[0], record.packedSize) || !decompress(packed, record.rawSize, raw)) {
+        raw = "[archive] log for " + name + " could not be read back\n";
+    }
+
+    auto proc = std::make_shared<Process>();
+    proc->name = record.name;
+    proc->pid = record.pid;
+    proc->arrivalTime = record.arrivalTime;
+    proc->startTime = record.startTime;
+    proc->endTime = record.endTime;
+    proc->totalInstructions = record.totalInstructions;
+    proc->instructionPointer = record.completedInstructions;
+    *proc->completedInstructions = record.completedInstructions;
+    proc->setStatus(ProcessStatus::DONE);
+
+    std::istringstream lines(raw);
+    std::string line;
+    while (std::getline(lines, line)) proc->logs.push_back(line);
+    return proc;
+}
+
+std::vector<ArchivedProcess> ProcessArchive::getRecords() const {
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    return records;
+}
+
+size_t ProcessArchive::getCount() const {
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    return records.size();
+}
+
+uint64_t ProcessArchive::getRawBytes() const {
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    return rawBytes;
+}
+
+uint64_t ProcessArchive::getPackedBytes() const {
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    return writeOffset;
+}
+
+void ProcessArchive::clear() {
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    if (out.is_open()) {
+        out.close();
+        std::remove(path.c_str());
+    }
+    records.clear();
+    byName.clear();
+    writeOffset = 0;
+    rawBytes = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef PROCESS_ARCHIVE_H
+#define PROCESS_ARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <unordered_map>
+#include <cstdint>
+#include "process.h"
+
+// What stays in memory for an evicted process
+struct ArchivedProcess {
+    std::string name;
+    int pid = -1;
+    std::string arrivalTime;
+    std::string startTime;
+    std::string endTime;
+    int totalInstructions = 0;
+    int completedInstructions = 0;
+    uint64_t offset = 0;     // start of the compressed log block in the archive file
+    uint32_t rawSize = 0;
+    uint32_t packedSize = 0;
+};
+
+// Append-only store for finished processes. Each archived log is compressed with a
+// small LZ77 coder (no external dependency) and written as one block; screen -r
+// rebuilds a read-only finished process from the summary and its block.
+class ProcessArchive {
+private:
+    ProcessArchive() = default;
+
+    mutable std::mutex archiveMutex;
+    std::ofstream out;
+    std::string path;
+    uint64_t writeOffset = 0;
+    uint64_t rawBytes = 0;
+    std::vector<ArchivedProcess> records;
+    std::unordered_map<std::string, size_t> byName;
+
+public:
+    static ProcessArchive& getInstance();
+
+    ProcessArchive(const ProcessArchive&) = delete;
+    ProcessArchive& operator=(const ProcessArchive&) = delete;
+
+    bool archive(const Process& proc);
+    bool contains(const std::string& name) const;
+    std::shared_ptr<Process> restore(const std::string& name) const;
+    std::vector<ArchivedProcess> getRecords() const;
+
+    size_t getCount() const;
+    uint64_t getRawBytes() const;
+    uint64_t getPackedBytes() const;
+    void clear();
+};
+
+#endif // PROCESS_ARCHIVE_H
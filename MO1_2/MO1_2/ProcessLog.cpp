@@ -0,0 +1,107 @@
+#include "ProcessLog.h"
+#include "config.h"
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+// Names of processes are reused (replay, restarts, archive restores), so each log spills to its own file
+static std::atomic<uint64_t> spillSequence{ 0 };
+
+ProcessLog::ProcessLog(const std::string& ownerName)
+    : owner(ownerName), capacity(std::max<size_t>(Config::getInstance().logBufferLines, 4)) {
+}
+
+ProcessLog::~ProcessLog() {
+    if (!spillFile.empty()) std::remove(spillFile.c_str());
+}
+
+void ProcessLog::push_back(std::string line) {
+    bytesAppended.fetch_add(line.size(), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        if (ring.empty()) ring.resize(capacity);
+        if (resident == capacity) spillOldest(capacity / 4);
+
+        ring[(head + resident) % capacity] = std::move(line);
+        resident++;
+    }
+    if (watchers.load(std::memory_order_relaxed) > 0) appended.notify_all();
+}
+
+size_t ProcessLog::waitForAppend(size_t seen, std::chrono::milliseconds timeout) const {
+    watchers++;
+    std::unique_lock<std::mutex> lock(logMutex);
+    appended.wait_for(lock, timeout, [&] { return spilled + resident != seen; });
+    size_t total = spilled + resident;
+    lock.unlock();
+    watchers--;
+    return total;
+}
+
+// Called with logMutex held. Spilling a quarter at a time keeps file opens rare.
+void ProcessLog::spillOldest(size_t count) {
+    if (spillFile.empty()) spillFile = owner + "_log." + std::to_string(spillSequence.fetch_add(1)) + ".spill";
+
+    // The first spill truncates, so lines left behind by an earlier run never precede this log's
+    std::ofstream out(spillFile, spilled == 0 ? std::ios::trunc : std::ios::app);
+    for (size_t i = 0; i < count; ++i) {
+        std::string& line = ring[head];
+        if (out.is_open()) out << line << "\n";
+        std::string().swap(line);
+        head = (head + 1) % capacity;
+    }
+    resident -= count;
+    spilled += count;
+}
+
+void ProcessLog::clear() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    for (auto& line : ring) std::string().swap(line);
+    head = 0;
+    resident = 0;
+    spilled = 0;
+    if (!spillFile.empty()) std::remove(spillFile.c_str());
+}
+
+size_t ProcessLog::size() const {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return spilled + resident;
+}
+
+size_t ProcessLog::residentSize() const {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return resident;
+}
+
+std::vector<std::string> ProcessLog::lines(size_t first, size_t count) const {
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::vector<std::string> result;
+    size_t end = std::min(first + count, spilled + resident);
+    if (first >= end) return result;
+    result.reserve(end - first);
+
+    if (first < spilled) {
+        std::ifstream in(spillFile);
+        std::string line;
+        for (size_t i = 0; i < std::min(end, spilled) && std::getline(in, line); ++i) {
+            if (i >= first) result.push_back(line);
+        }
+        first = spilled;
+    }
+    for (size_t i = first; i < end; ++i) {
+        result.push_back(ring[(head + i - spilled) % capacity]);
+    }
+    return result;
+}
+
+void ProcessLog::writeAll(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (spilled > 0) {
+        std::ifstream in(spillFile);
+        std::string line;
+        while (std::getline(in, line)) out << line << "\n";
+    }
+    for (size_t i = 0; i < resident; ++i) {
+        out << ring[(head + i) % capacity] << "\n";
+    }
+}
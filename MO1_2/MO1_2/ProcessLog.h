@@ -0,0 +1,57 @@
+#ifndef PROCESS_LOG_H
+#define PROCESS_LOG_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+
+// Fixed-capacity log of one process. The newest log-buffer-lines entries stay in
+// memory; once the ring is full the oldest quarter is appended to <process>_log.<n>.spill
+// (n unique per log object) and only read back when a viewer asks for lines older than the in-memory window.
+class ProcessLog {
+private:
+    const std::string& owner;  // the owning process's name
+    size_t capacity;
+    std::vector<std::string> ring;
+    size_t head = 0;      // ring index of the oldest resident line
+    size_t resident = 0;
+    size_t spilled = 0;   // lines on disk, all older than the resident ones
+    std::string spillFile;
+    mutable std::mutex logMutex;
+    mutable std::condition_variable appended;
+    mutable std::atomic<int> watchers{ 0 };  // cores only notify while a view is attached
+    std::atomic<uint64_t> bytesAppended{ 0 };
+
+    void spillOldest(size_t count);
+
+public:
+    explicit ProcessLog(const std::string& ownerName);
+    ~ProcessLog();
+
+    ProcessLog(const ProcessLog&) = delete;
+    ProcessLog& operator=(const ProcessLog&) = delete;
+
+    void push_back(std::string line);
+    void clear();
+
+    // Counts include spilled lines
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    size_t residentSize() const;
+    // Total bytes of every line ever appended, spilled or not
+    uint64_t bytesLogged() const { return bytesAppended.load(std::memory_order_relaxed); }
+
+    // Blocks until the log grows past seen lines or the timeout expires; returns the new size
+    size_t waitForAppend(size_t seen, std::chrono::milliseconds timeout) const;
+
+    // Lines [first, first + count) in logging order; spilled ones are read back from disk
+    std::vector<std::string> lines(size_t first, size_t count) const;
+    void writeAll(std::ostream& out) const;
+};
+
+#endif // PROCESS_LOG_H
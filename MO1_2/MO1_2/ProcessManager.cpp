@@ -8,18 +8,37 @@
 #include "PrintInstruction.h"
 #include "SleepInstruction.h"
 #include "ForInstruction.h"
+#include "ReadInstruction.h"
+#include "WriteInstruction.h"
 #include <random>
 #include <sstream>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <algorithm>
+#include <mutex>
+#include <deque>
 #include "config.h"
+#include "ProcessArchive.h"
+#include "ProgramCache.h"
 
 static std::vector<std::shared_ptr<Process>> allProcesses;
 static std::unordered_map<std::string, std::shared_ptr<Process>> processMap;
 static int pidCounter = 1000;
 static int uniqueProcessCounter = 1;
+// Finished processes still resident, oldest first
+static std::deque<std::shared_ptr<Process>> retiredProcesses;
+// Guards the registry above; the cores never take it, only the generator and CLI/report threads
+static std::mutex registryMutex;
+
+// Hands out per-process generation seeds; seeded from config so a run can be reproduced
+static unsigned int nextProcessSeed() {
+    static std::mt19937 seedSource([] {
+        unsigned int seed = Config::getInstance().seed;
+        return seed != 0 ? seed : std::random_device{}();
+        }());
+    return static_cast<unsigned int>(seedSource());
+}
 
 //std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name, int pid, int minInstructions, int maxInstructions) {
 //    auto proc = std::make_shared<Process>();
@@ -152,9 +171,14 @@ static int uniqueProcessCounter = 1;
 //    return proc;
 //}
 std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name, int pid, int minInstructions, int maxInstructions, size_t memPerProc) {
+    return createProcess(name, pid, minInstructions, maxInstructions, memPerProc, nextProcessSeed());
+}
+
+std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name, int pid, int minInstructions, int maxInstructions, size_t memPerProc, unsigned int seed) {
     auto proc = std::make_shared<Process>();
     proc->pid = pid;
     proc->name = name;
+    proc->seed = seed;
     proc->instructionPointer = 0;
     proc->coreAssigned = -1;
     proc->isRunning = false;
@@ -163,14 +187,23 @@ std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name,
     proc->completedInstructions = std::make_shared<std::atomic<int>>(0);
     proc->setRequiredMemory(memPerProc);
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> instructionCount(minInstructions, maxInstructions);
+    std::mt19937 gen(seed);
     std::uniform_int_distribution<> opPicker(0, 4); // 0=Declare,1=Add,2=Sub,3=Print,4=Sleep
     std::uniform_int_distribution<> valDist(1, 100);
     std::uniform_int_distribution<> sleepDist(100, 500);
 
-    int numInstructions = instructionCount(gen);
+    // READ/WRITE are only drawn when enabled, so existing seeds keep their instruction streams
+    const int memoryOpPercent = std::min(std::max(Config::getInstance().memoryOpPercent, 0), 100);
+    const int words = static_cast<int>(std::max<size_t>(memPerProc / 2, 1));
+    std::uniform_int_distribution<> percentDist(0, 99);
+    std::uniform_int_distribution<> wordDist(0, words - 1);
+    std::uniform_int_distribution<> strideDist(-4, 4);
+    int lastWord = 0;
+
+    // Exactly one draw regardless of the range, so a process re-created from its seed with
+    // its final count (min == max, as trace replay does) gets the same instruction stream
+    unsigned int span = static_cast<unsigned int>(std::max(maxInstructions - minInstructions, 0)) + 1;
+    int numInstructions = minInstructions + static_cast<int>(gen() % span);
     proc->totalInstructions = numInstructions;
 
     // Always start with x=0
@@ -178,6 +211,17 @@ std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name,
     int count = 1;
 
     while (count < numInstructions) {
+        if (memoryOpPercent > 0 && percentDist(gen) < memoryOpPercent) {
+            // Mostly a few words from the previous access, sometimes anywhere in the region
+            int word = percentDist(gen) < 80 ? std::min(std::max(lastWord + strideDist(gen), 0), words - 1) : wordDist(gen);
+            lastWord = word;
+            size_t address = static_cast<size_t>(word) * 2;
+            if (percentDist(gen) < 50) proc->instructions.push_back(std::make_shared<ReadInstruction>("x", address));
+            else proc->instructions.push_back(std::make_shared<WriteInstruction>(address, "x"));
+            count++;
+            continue;
+        }
+
         int op = opPicker(gen);
         switch (op) {
         case 0: {
@@ -211,26 +255,68 @@ std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name,
 
 std::shared_ptr<Process> ProcessManager::createUniqueNamedProcess(int minIns, int maxIns, size_t memPerProc) {
     std::string processName;
-    do {
-        processName = "process_" + std::to_string(uniqueProcessCounter++);
-    } while (processMap.find(processName) != processMap.end());
-    return createProcess(processName, pidCounter++, minIns, maxIns, memPerProc);
+    int pid;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        do {
+            processName = "process_" + std::to_string(uniqueProcessCounter++);
+        } while (processMap.find(processName) != processMap.end() || ProcessArchive::getInstance().contains(processName));
+        pid = pidCounter++;
+    }
+    return createProcess(processName, pid, minIns, maxIns, memPerProc);
 }
 
 std::shared_ptr<Process> ProcessManager::createNamedProcess(const std::string& name) {
-    if (processMap.find(name) != processMap.end()) {
-        return processMap[name];
+    int pid;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = processMap.find(name);
+        if (it != processMap.end()) {
+            return it->second;
+        }
+        pid = pidCounter++;
     }
     const auto& config = Config::getInstance();
-    return createProcess(name, pidCounter++, config.minInstructions, config.maxInstructions, config.memPerProc);
+    return createProcess(name, pid, config.minInstructions, config.maxInstructions, config.memPerProc);
+}
+
+std::shared_ptr<Process> ProcessManager::createNamedProcess(const std::string& name, std::shared_ptr<const Program> program) {
+    int pid;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = processMap.find(name);
+        if (it != processMap.end()) {
+            return it->second;
+        }
+        pid = pidCounter++;
+    }
+    auto proc = std::make_shared<Process>();
+    proc->pid = pid;
+    proc->name = name;
+    proc->instructionPointer = 0;
+    proc->coreAssigned = -1;
+    proc->isRunning = false;
+    proc->isFinished = false;
+    proc->isDetached = false;
+    proc->setRequiredMemory(Config::getInstance().memPerProc);
+
+    // Copies pointers only; the instruction objects stay shared with the cache
+    proc->instructions = program->instructions;
+    proc->totalInstructions = static_cast<int>(proc->instructions.size());
+    return proc;
 }
 
 std::shared_ptr<Process> ProcessManager::findByName(const std::string& name) {
-    auto it = processMap.find(name);
-    return (it != processMap.end()) ? it->second : nullptr;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = processMap.find(name);
+        if (it != processMap.end()) return it->second;
+    }
+    return ProcessArchive::getInstance().restore(name);
 }
 
 std::shared_ptr<Process> ProcessManager::findByPid(int pid) {
+    std::lock_guard<std::mutex> lock(registryMutex);
     auto it = std::find_if(allProcesses.begin(), allProcesses.end(),
         [pid](const std::shared_ptr<Process>& p) { return p->pid == pid; });
     return (it != allProcesses.end()) ? *it : nullptr;
@@ -238,19 +324,48 @@ std::shared_ptr<Process> ProcessManager::findByPid(int pid) {
 
 void ProcessManager::addProcess(std::shared_ptr<Process> proc) {
     if (!proc) return;
-    auto it = std::find_if(allProcesses.begin(), allProcesses.end(),
-        [&proc](const std::shared_ptr<Process>& p) { return p->name == proc->name; });
-    if (it == allProcesses.end()) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (processMap.find(proc->name) == processMap.end()) {
         allProcesses.push_back(proc);
         processMap[proc->name] = proc;
     }
 }
 
+void ProcessManager::retire(std::shared_ptr<Process> proc) {
+    if (!proc) return;
+    std::vector<std::shared_ptr<Process>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (processMap.find(proc->name) == processMap.end()) return;
+        retiredProcesses.push_back(proc);
+        while (retiredProcesses.size() > Config::getInstance().residentFinished) {
+            evicted.push_back(retiredProcesses.front());
+            retiredProcesses.pop_front();
+        }
+    }
+    if (evicted.empty()) return;
+
+    // Archive before unregistering so a lookup always finds the process in one place or the other
+    auto& archive = ProcessArchive::getInstance();
+    for (auto it = evicted.begin(); it != evicted.end();) {
+        if (archive.archive(**it)) ++it;
+        else it = evicted.erase(it);  // keep it resident if the archive cannot be written
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& p : evicted) {
+        processMap.erase(p->name);
+        allProcesses.erase(std::remove(allProcesses.begin(), allProcesses.end(), p), allProcesses.end());
+    }
+}
+
 std::vector<std::shared_ptr<Process>> ProcessManager::getAllProcesses() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     return allProcesses;
 }
 
 std::vector<std::shared_ptr<Process>> ProcessManager::getRunningProcesses() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     std::vector<std::shared_ptr<Process>> running;
     std::copy_if(allProcesses.begin(), allProcesses.end(), std::back_inserter(running),
         [](const std::shared_ptr<Process>& p) { return p->isRunning && !p->isFinished; });
@@ -258,13 +373,15 @@ std::vector<std::shared_ptr<Process>> ProcessManager::getRunningProcesses() {
 }
 
 std::vector<std::shared_ptr<Process>> ProcessManager::getFinishedProcesses() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     std::vector<std::shared_ptr<Process>> finished;
     std::copy_if(allProcesses.begin(), allProcesses.end(), std::back_inserter(finished),
-        [](const std::shared_ptr<Process>& p) { return p->isFinished; });
+        [](const std::shared_ptr<Process>& p) { return p->isFinished.load(); });
     return finished;
 }
 
 std::vector<std::shared_ptr<Process>> ProcessManager::getWaitingProcesses() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     std::vector<std::shared_ptr<Process>> waiting;
     std::copy_if(allProcesses.begin(), allProcesses.end(), std::back_inserter(waiting),
         [](const std::shared_ptr<Process>& p) { return !p->isRunning && !p->isFinished; });
@@ -272,29 +389,40 @@ std::vector<std::shared_ptr<Process>> ProcessManager::getWaitingProcesses() {
 }
 
 int ProcessManager::getProcessCount() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     return static_cast<int>(allProcesses.size());
 }
 
 int ProcessManager::getRunningProcessCount() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     return static_cast<int>(std::count_if(allProcesses.begin(), allProcesses.end(),
         [](const std::shared_ptr<Process>& p) { return p->isRunning && !p->isFinished; }));
 }
 
 int ProcessManager::getFinishedProcessCount() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     return static_cast<int>(std::count_if(allProcesses.begin(), allProcesses.end(),
-        [](const std::shared_ptr<Process>& p) { return p->isFinished; }));
-}
-
-double ProcessManager::getCpuUtilization() {
-    int numCPU = Config::getInstance().numCPU;
-    if (numCPU == 0) return 0.0;
-    int running = getRunningProcessCount();
-    return (static_cast<double>(running) / numCPU) * 100.0;
+        [](const std::shared_ptr<Process>& p) { return p->isFinished.load(); }));
 }
 
 void ProcessManager::clearAllProcesses() {
+    std::lock_guard<std::mutex> lock(registryMutex);
     allProcesses.clear();
     processMap.clear();
+    retiredProcesses.clear();
+    ProcessArchive::getInstance().clear();
     pidCounter = 1000;
     uniqueProcessCounter = 1;
-}
\ No newline at end of file
+}
+
+void ProcessManager::getCounters(int& nextPid, int& nextUniqueName) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    nextPid = pidCounter;
+    nextUniqueName = uniqueProcessCounter;
+}
+
+void ProcessManager::setCounters(int nextPid, int nextUniqueName) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    pidCounter = nextPid;
+    uniqueProcessCounter = nextUniqueName;
+}
@@ -4,13 +4,21 @@
 #include <vector>
 #include "process.h"
 
+struct Program;
+
 class ProcessManager {
 public:
     static std::shared_ptr<Process> createProcess(const std::string& name, int pid, int minInstructions, int maxInstructions, size_t memPerProc);
+    static std::shared_ptr<Process> createProcess(const std::string& name, int pid, int minInstructions, int maxInstructions, size_t memPerProc, unsigned int seed);
     static std::shared_ptr<Process> createUniqueNamedProcess(int minIns, int maxIns, size_t memPerProc);
     static std::shared_ptr<Process> createNamedProcess(const std::string& name);
+    // Runs a parsed program file instead of a generated instruction stream
+    static std::shared_ptr<Process> createNamedProcess(const std::string& name, std::shared_ptr<const Program> program);
+    // Falls back to the archive for evicted processes
     static std::shared_ptr<Process> findByName(const std::string& name);
     static void addProcess(std::shared_ptr<Process> proc);
+    // Called once a process has finished for good; evicts the oldest finished processes to the archive
+    static void retire(std::shared_ptr<Process> proc);
     static std::vector<std::shared_ptr<Process>> getAllProcesses();
     static std::vector<std::shared_ptr<Process>> getWaitingProcesses();
     static std::vector<std::shared_ptr<Process>> getRunningProcesses();     
@@ -19,6 +27,8 @@ public:
     static int getProcessCount();
     static int getRunningProcessCount();
     static int getFinishedProcessCount();
-    static double getCpuUtilization();
     static void clearAllProcesses();
+    // Name/PID counters, saved and restored with checkpoints
+    static void getCounters(int& nextPid, int& nextUniqueName);
+    static void setCounters(int nextPid, int nextUniqueName);
 };
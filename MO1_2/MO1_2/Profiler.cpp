@@ -0,0 +1,208 @@
+#include "Profiler.h"
+#include "process.h"
+#include "scheduler.h"
+#include "ProcessManager.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+    OpcodeTable tableOf(const OpcodeProfile& profile) {
+        OpcodeTable table;
+        for (int i = 0; i < OPCODE_COUNT; ++i) {
+            table[i] = { profile.getExecutions(i), profile.getHostNs(i), profile.getLogBytes(i) };
+        }
+        return table;
+    }
+
+    OpcodeTable difference(const OpcodeTable& after, const OpcodeTable* before) {
+        OpcodeTable delta = after;
+        if (!before) return delta;
+        for (int i = 0; i < OPCODE_COUNT; ++i) {
+            delta[i].executions -= (*before)[i].executions;
+            delta[i].hostNs -= (*before)[i].hostNs;
+            delta[i].logBytes -= (*before)[i].logBytes;
+        }
+        return delta;
+    }
+
+    void accumulate(OpcodeTable& into, const OpcodeTable& table) {
+        for (int i = 0; i < OPCODE_COUNT; ++i) {
+            into[i].executions += table[i].executions;
+            into[i].hostNs += table[i].hostNs;
+            into[i].logBytes += table[i].logBytes;
+        }
+    }
+
+    OpcodeTotals sum(const OpcodeTable& table) {
+        OpcodeTotals total;
+        for (const auto& row : table) {
+            total.executions += row.executions;
+            total.hostNs += row.hostNs;
+            total.logBytes += row.logBytes;
+        }
+        return total;
+    }
+
+    double perTick(uint64_t value, int ticks) {
+        return ticks > 0 ? static_cast<double>(value) / ticks : 0.0;
+    }
+
+    double toMs(uint64_t ns) {
+        return static_cast<double>(ns) / 1e6;
+    }
+}
+
+const char* opcodeName(Opcode opcode) {
+    static const char* names[] = { "DECLARE", "ADD", "SUBTRACT", "PRINT", "SLEEP", "FOR", "READ", "WRITE" };
+    int i = static_cast<int>(opcode);
+    return i < OPCODE_COUNT ? names[i] : "?";
+}
+
+Profiler::Profiler() : cores(new OpcodeProfile[MAX_CORES]) {}
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::record(Process& process, int coreId, Opcode opcode, uint64_t nanoseconds, uint64_t logBytes) {
+    process.profile.add(opcode, nanoseconds, logBytes);
+    if (coreId >= 0 && coreId < MAX_CORES) cores[coreId].add(opcode, nanoseconds, logBytes);
+}
+
+OpcodeTable Profiler::coreTotals() const {
+    OpcodeTable totals{};
+    for (int core = 0; core < MAX_CORES; ++core) accumulate(totals, tableOf(cores[core]));
+    return totals;
+}
+
+ProfileSample Profiler::capture() const {
+    SystemSnapshot snapshot = takeSnapshot();
+    ProfileSample sample;
+    sample.tick = snapshot.tick;
+    for (const auto& core : snapshot.cores) {
+        if (core.coreId < 0 || core.coreId >= MAX_CORES) continue;
+        sample.cores.push_back(tableOf(cores[core.coreId]));
+        sample.busyTicks.push_back(core.busyTicks);
+    }
+
+    std::unordered_map<int, int> pidToCore;
+    for (const auto& core : snapshot.cores) {
+        if (core.process) pidToCore[core.process->pid] = core.coreId;
+    }
+    for (const auto& process : ProcessManager::getAllProcesses()) {
+        ProfileSample::ProcessEntry& entry = sample.processes[process->pid];
+        entry.name = process->name;
+        auto core = pidToCore.find(process->pid);
+        entry.coreId = core == pidToCore.end() ? -1 : core->second;
+        entry.finished = process->getIsFinished();
+        entry.opcodes = tableOf(process->profile);
+    }
+    return sample;
+}
+
+void Profiler::writeTop(std::ostream& out, const ProfileSample& before, const ProfileSample& after, size_t maxProcesses) const {
+    std::ios_base::fmtflags flags(out.flags());
+    std::streamsize precision = out.precision();
+    int ticks = after.tick - before.tick;
+
+    out << "\n=== TOP: ticks " << before.tick << "-" << after.tick << " (" << ticks << " ticks) ===\n";
+    out << std::fixed << std::setprecision(1);
+
+    out << "CORES:\n";
+    out << "  " << std::left << std::setw(8) << "core" << std::right << std::setw(10) << "instr"
+        << std::setw(12) << "instr/tick" << std::setw(8) << "busy%" << std::setw(11) << "host ms" << "\n";
+    OpcodeTable opcodes{};
+    for (size_t core = 0; core < after.cores.size(); ++core) {
+        bool known = core < before.cores.size();
+        OpcodeTable delta = difference(after.cores[core], known ? &before.cores[core] : nullptr);
+        accumulate(opcodes, delta);
+        OpcodeTotals total = sum(delta);
+        uint64_t busy = after.busyTicks[core] - (known ? before.busyTicks[core] : 0);
+        out << "  " << std::left << std::setw(8) << ("Core " + std::to_string(core)) << std::right
+            << std::setw(10) << total.executions << std::setw(12) << perTick(total.executions, ticks)
+            << std::setw(8) << perTick(busy * 100, ticks) << std::setw(11) << toMs(total.hostNs) << "\n";
+    }
+    if (after.cores.empty()) out << "  Scheduler not started.\n";
+
+    out << "OPCODES:\n";
+    out << "  " << std::left << std::setw(10) << "opcode" << std::right << std::setw(10) << "execs"
+        << std::setw(12) << "execs/tick" << std::setw(10) << "avg ns" << std::setw(11) << "host ms"
+        << std::setw(10) << "log KB" << "\n";
+    for (int i = 0; i < OPCODE_COUNT; ++i) {
+        const OpcodeTotals& row = opcodes[i];
+        out << "  " << std::left << std::setw(10) << opcodeName(static_cast<Opcode>(i)) << std::right
+            << std::setw(10) << row.executions << std::setw(12) << perTick(row.executions, ticks)
+            << std::setw(10) << std::setprecision(0) << (row.executions ? static_cast<double>(row.hostNs) / row.executions : 0.0)
+            << std::setprecision(1) << std::setw(11) << toMs(row.hostNs)
+            << std::setw(10) << static_cast<double>(row.logBytes) / 1024.0 << "\n";
+    }
+
+    struct ProcessRow {
+        int pid;
+        const ProfileSample::ProcessEntry* entry;
+        OpcodeTable delta;
+        OpcodeTotals total;
+    };
+    std::vector<ProcessRow> rows;
+    for (const auto& item : after.processes) {
+        auto previous = before.processes.find(item.first);
+        OpcodeTable delta = difference(item.second.opcodes, previous == before.processes.end() ? nullptr : &previous->second.opcodes);
+        OpcodeTotals total = sum(delta);
+        if (total.executions > 0) rows.push_back({ item.first, &item.second, delta, total });
+    }
+    std::sort(rows.begin(), rows.end(), [](const ProcessRow& a, const ProcessRow& b) {
+        return a.total.executions != b.total.executions ? a.total.executions > b.total.executions : a.pid < b.pid;
+        });
+
+    out << "PROCESSES (top " << std::min(maxProcesses, rows.size()) << " of " << rows.size() << " active):\n";
+    out << "  " << std::left << std::setw(16) << "name" << std::right << std::setw(7) << "pid" << std::setw(7) << "core"
+        << std::setw(10) << "instr" << std::setw(12) << "instr/tick" << std::setw(11) << "host ms"
+        << "  " << std::left << "hottest" << "\n";
+    for (size_t r = 0; r < rows.size() && r < maxProcesses; ++r) {
+        const ProcessRow& row = rows[r];
+        int hottest = 0;
+        for (int i = 1; i < OPCODE_COUNT; ++i) {
+            if (row.delta[i].hostNs > row.delta[hottest].hostNs) hottest = i;
+        }
+        std::string core = row.entry->finished ? "done" : row.entry->coreId >= 0 ? std::to_string(row.entry->coreId) : "-";
+        out << "  " << std::left << std::setw(16) << row.entry->name << std::right << std::setw(7) << row.pid
+            << std::setw(7) << core << std::setw(10) << row.total.executions
+            << std::setw(12) << perTick(row.total.executions, ticks) << std::setw(11) << toMs(row.total.hostNs)
+            << "  " << std::left << opcodeName(static_cast<Opcode>(hottest)) << "\n";
+    }
+    out << "\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Profiler::writeMetrics(std::ostream& out) const {
+    OpcodeTable totals = coreTotals();
+    const std::pair<const char*, const char*> series[] = {
+        { "csopesy_opcode_executions_total", "Instructions executed, by opcode." },
+        { "csopesy_opcode_host_seconds_total", "Host time spent executing instructions, by opcode." },
+        { "csopesy_opcode_log_bytes_total", "Process log bytes produced, by opcode." }
+    };
+    for (int s = 0; s < 3; ++s) {
+        out << "# HELP " << series[s].first << " " << series[s].second << "\n";
+        out << "# TYPE " << series[s].first << " counter\n";
+        for (int i = 0; i < OPCODE_COUNT; ++i) {
+            out << series[s].first << "{opcode=\"" << opcodeName(static_cast<Opcode>(i)) << "\"} ";
+            if (s == 0) out << totals[i].executions;
+            else if (s == 1) out << static_cast<double>(totals[i].hostNs) / 1e9;
+            else out << totals[i].logBytes;
+            out << "\n";
+        }
+    }
+}
+
+void Profiler::writeJson(std::ostream& out) const {
+    OpcodeTable totals = coreTotals();
+    out << "{";
+    for (int i = 0; i < OPCODE_COUNT; ++i) {
+        out << (i ? ", " : "") << "\"" << opcodeName(static_cast<Opcode>(i)) << "\": {\"executions\": " << totals[i].executions
+            << ", \"host_ns\": " << totals[i].hostNs << ", \"log_bytes\": " << totals[i].logBytes << "}";
+    }
+    out << "}";
+}
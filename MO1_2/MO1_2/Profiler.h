@@ -0,0 +1,103 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Process;
+
+enum class Opcode : uint8_t {
+    DECLARE,
+    ADD,
+    SUBTRACT,
+    PRINT,
+    SLEEP,
+    FOR,     // timed as a whole, including its body
+    READ,
+    WRITE,
+    COUNT
+};
+
+constexpr int OPCODE_COUNT = static_cast<int>(Opcode::COUNT);
+const char* opcodeName(Opcode opcode);
+
+// Per-opcode executions, host time spent in execute() and log bytes produced. Each
+// table has a single writer at a time (the core running the process, or the core that
+// owns the slot), so updates are plain relaxed load/store pairs rather than RMWs.
+class OpcodeProfile {
+public:
+    void add(Opcode opcode, uint64_t nanoseconds, uint64_t logBytes) {
+        int i = static_cast<int>(opcode);
+        bump(executions[i], 1);
+        bump(hostNs[i], nanoseconds);
+        bump(logged[i], logBytes);
+    }
+
+    uint64_t getExecutions(int i) const { return executions[i].load(std::memory_order_relaxed); }
+    uint64_t getHostNs(int i) const { return hostNs[i].load(std::memory_order_relaxed); }
+    uint64_t getLogBytes(int i) const { return logged[i].load(std::memory_order_relaxed); }
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, OPCODE_COUNT> executions{};
+    std::array<std::atomic<uint64_t>, OPCODE_COUNT> hostNs{};
+    std::array<std::atomic<uint64_t>, OPCODE_COUNT> logged{};
+};
+
+struct OpcodeTotals {
+    uint64_t executions = 0;
+    uint64_t hostNs = 0;
+    uint64_t logBytes = 0;
+};
+using OpcodeTable = std::array<OpcodeTotals, OPCODE_COUNT>;
+
+// Point-in-time copy of every counter; top prints the difference of two of these
+struct ProfileSample {
+    struct ProcessEntry {
+        std::string name;
+        int coreId = -1;
+        bool finished = false;
+        OpcodeTable opcodes{};
+    };
+
+    int tick = 0;
+    std::vector<OpcodeTable> cores;      // indexed by core id
+    std::vector<uint64_t> busyTicks;     // indexed by core id
+    std::unordered_map<int, ProcessEntry> processes;
+};
+
+class Profiler {
+private:
+    Profiler();
+
+    std::unique_ptr<OpcodeProfile[]> cores;  // one slot per possible core
+
+    OpcodeTable coreTotals() const;
+
+public:
+    static Profiler& getInstance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Called by the core after every instruction; adds to the process's and the core's tables
+    void record(Process& process, int coreId, Opcode opcode, uint64_t nanoseconds, uint64_t logBytes);
+
+    ProfileSample capture() const;
+    // Hottest processes, every opcode and every core between two captures (before may be
+    // empty for totals since startup)
+    void writeTop(std::ostream& out, const ProfileSample& before, const ProfileSample& after, size_t maxProcesses) const;
+    void writeMetrics(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,279 @@
+#include "ProgramCache.h"
+#include "DeclareInstruction.h"
+#include "AddInstruction.h"
+#include "SubtractInstruction.h"
+#include "PrintInstruction.h"
+#include "SleepInstruction.h"
+#include "ForInstruction.h"
+#include "ReadInstruction.h"
+#include "WriteInstruction.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const uint64_t UINT16_LIMIT = 65535;
+const uint64_t ADDRESS_LIMIT = 0xFFFFFFFFu;  // checkpoints store addresses as 32 bits
+const uint64_t SLEEP_LIMIT = 0x7FFFFFFF;
+
+uint64_t hashSource(const std::string& source) {
+    uint64_t hash = 14695981039346656037ull;  // FNV-1a
+    for (unsigned char c : source) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+class ProgramParser {
+private:
+    const std::string& src;
+    size_t pos = 0;
+    int line = 1;
+    std::string& error;
+
+    bool fail(const std::string& message) {
+        if (error.empty()) error = "line " + std::to_string(line) + ": " + message;
+        return false;
+    }
+
+    // Whitespace, newlines and # or // comments
+    void skipBlank() {
+        while (pos < src.size()) {
+            char c = src[pos];
+            if (c == '\n') {
+                line++;
+                pos++;
+            }
+            else if (std::isspace(static_cast<unsigned char>(c))) pos++;
+            else if (c == '#' || (c == '/' && pos + 1 < src.size() && src[pos + 1] == '/')) {
+                while (pos < src.size() && src[pos] != '\n') pos++;
+            }
+            else break;
+        }
+    }
+
+    bool peek(char c) {
+        skipBlank();
+        return pos < src.size() && src[pos] == c;
+    }
+
+    bool expect(char c) {
+        if (!peek(c)) return fail(std::string("expected '") + c + "'");
+        pos++;
+        return true;
+    }
+
+    bool identifier(std::string& out) {
+        skipBlank();
+        if (pos >= src.size() || !(std::isalpha(static_cast<unsigned char>(src[pos])) || src[pos] == '_')) {
+            return fail("expected a variable name");
+        }
+        size_t start = pos;
+        while (pos < src.size() && (std::isalnum(static_cast<unsigned char>(src[pos])) || src[pos] == '_')) pos++;
+        out = src.substr(start, pos - start);
+        return true;
+    }
+
+    // Decimal or 0x-prefixed hexadecimal
+    bool number(uint64_t& out, uint64_t limit, const char* what) {
+        skipBlank();
+        int base = 10;
+        if (src.compare(pos, 2, "0x") == 0 || src.compare(pos, 2, "0X") == 0) {
+            base = 16;
+            pos += 2;
+        }
+        size_t start = pos;
+        out = 0;
+        while (pos < src.size() && std::isxdigit(static_cast<unsigned char>(src[pos]))) {
+            char c = static_cast<char>(std::tolower(static_cast<unsigned char>(src[pos])));
+            int digit = std::isdigit(static_cast<unsigned char>(c)) ? c - '0' : c - 'a' + 10;
+            if (digit >= base) break;
+            out = out * base + digit;
+            if (out > limit) return fail(std::string(what) + " is larger than " + std::to_string(limit));
+            pos++;
+        }
+        if (pos == start) return fail(std::string("expected ") + what);
+        return true;
+    }
+
+    // A variable or a 16-bit literal; the instructions resolve variables first at run time
+    bool operand(std::string& out) {
+        skipBlank();
+        if (pos < src.size() && std::isdigit(static_cast<unsigned char>(src[pos]))) {
+            uint64_t value = 0;
+            if (!number(value, UINT16_LIMIT, "a value")) return false;
+            out = std::to_string(value);
+            return true;
+        }
+        return identifier(out);
+    }
+
+    bool stringLiteral(std::string& out) {
+        if (!expect('"')) return false;
+        out.clear();
+        while (pos < src.size() && src[pos] != '"' && src[pos] != '\n') {
+            if (src[pos] == '\\' && pos + 1 < src.size() && src[pos + 1] != '\n') pos++;
+            out += src[pos++];
+        }
+        if (pos >= src.size() || src[pos] != '"') return fail("unterminated string");
+        pos++;
+        return true;
+    }
+
+    bool statement(std::vector<std::shared_ptr<Instruction>>& out, int nesting) {
+        std::string name;
+        skipBlank();
+        if (pos >= src.size() || !std::isalpha(static_cast<unsigned char>(src[pos]))) return fail("expected an instruction");
+        if (!identifier(name)) return false;
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+        int startLine = line;
+        if (!expect('(')) return false;
+
+        if (name == "DECLARE") {
+            std::string var;
+            uint64_t value = 0;
+            if (!identifier(var) || !expect(',') || !number(value, UINT16_LIMIT, "a value")) return false;
+            out.push_back(std::make_shared<DeclareInstruction>(var, static_cast<int>(value)));
+        }
+        else if (name == "ADD" || name == "SUBTRACT") {
+            std::string result, lhs, rhs;
+            if (!identifier(result) || !expect(',') || !operand(lhs) || !expect(',') || !operand(rhs)) return false;
+            if (name == "ADD") out.push_back(std::make_shared<AddInstruction>(result, lhs, rhs));
+            else out.push_back(std::make_shared<SubtractInstruction>(result, lhs, rhs));
+        }
+        else if (name == "PRINT") {
+            std::string message, var;
+            if (peek('"')) {
+                if (!stringLiteral(message)) return false;
+                if (peek('+')) {
+                    pos++;
+                    if (!identifier(var)) return false;
+                }
+            }
+            else if (!identifier(var)) return fail("PRINT takes \"text\", a variable or \"text\" + variable");
+            if (var.empty()) out.push_back(std::make_shared<PrintInstruction>(message));
+            else out.push_back(std::make_shared<PrintInstruction>(message, var, true));
+        }
+        else if (name == "SLEEP") {
+            uint64_t ms = 0;
+            if (!number(ms, SLEEP_LIMIT, "a duration")) return false;
+            out.push_back(std::make_shared<SleepInstruction>(static_cast<int>(ms)));
+        }
+        else if (name == "FOR") {
+            if (nesting >= MAX_FOR_NESTING) {
+                return fail("FOR nested deeper than " + std::to_string(MAX_FOR_NESTING) + " levels");
+            }
+            std::vector<std::shared_ptr<Instruction>> body;
+            uint64_t repeats = 0;
+            if (!expect('[') || !sequence(body, nesting + 1, ']') || !expect(',') || !number(repeats, UINT16_LIMIT, "a repeat count")) return false;
+            if (repeats == 0) return fail("FOR repeat count must be at least 1");
+            if (body.empty()) return fail("FOR body is empty");
+            out.push_back(std::make_shared<ForInstruction>(static_cast<int>(repeats), body, nesting + 1));
+        }
+        else if (name == "READ") {
+            std::string var;
+            uint64_t address = 0;
+            if (!identifier(var) || !expect(',') || !number(address, ADDRESS_LIMIT, "an address")) return false;
+            out.push_back(std::make_shared<ReadInstruction>(var, static_cast<size_t>(address)));
+        }
+        else if (name == "WRITE") {
+            uint64_t address = 0;
+            std::string value;
+            if (!number(address, ADDRESS_LIMIT, "an address") || !expect(',') || !operand(value)) return false;
+            out.push_back(std::make_shared<WriteInstruction>(static_cast<size_t>(address), value));
+        }
+        else {
+            line = startLine;
+            return fail("unknown instruction '" + name + "'");
+        }
+        return expect(')');
+    }
+
+public:
+    ProgramParser(const std::string& source, std::string& error) : src(source), error(error) {}
+
+    // Statements up to terminator ('\0' = end of input), optionally separated by ';'
+    bool sequence(std::vector<std::shared_ptr<Instruction>>& out, int nesting, char terminator) {
+        while (true) {
+            while (peek(';')) pos++;
+            if (terminator == '\0' ? pos >= src.size() : peek(terminator)) break;
+            if (pos >= src.size()) return fail(std::string("expected '") + terminator + "'");
+            if (!statement(out, nesting)) return false;
+        }
+        if (terminator != '\0') pos++;
+        return true;
+    }
+};
+
+}
+
+bool parseProgram(const std::string& source, std::vector<std::shared_ptr<Instruction>>& instructions, std::string& error) {
+    error.clear();
+    // Files saved by Notepad start with a UTF-8 byte order mark
+    std::string text = source.compare(0, 3, "\xEF\xBB\xBF") == 0 ? source.substr(3) : source;
+    ProgramParser parser(text, error);
+    std::vector<std::shared_ptr<Instruction>> parsed;
+    if (!parser.sequence(parsed, 0, '\0')) return false;
+    if (parsed.empty()) {
+        error = "no instructions";
+        return false;
+    }
+    instructions = std::move(parsed);
+    return true;
+}
+
+ProgramCache& ProgramCache::getInstance() {
+    static ProgramCache instance;
+    return instance;
+}
+
+std::shared_ptr<const Program> ProgramCache::load(const std::string& filename, std::string& error) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + filename;
+        return nullptr;
+    }
+    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    uint64_t hash = hashSource(source);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = programs.find(hash);
+        if (it != programs.end() && it->second->source == source) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+
+    // Parsed outside the lock; if two first launches race, the first insert wins
+    auto program = std::make_shared<Program>();
+    program->hash = hash;
+    program->source = std::move(source);
+    if (!parseProgram(program->source, program->instructions, error)) return nullptr;
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto inserted = programs.emplace(hash, program);
+    // A different file with the same hash keeps the slot; this one just runs uncached
+    if (inserted.first->second->source != program->source) return program;
+    return inserted.first->second;
+}
+
+size_t ProgramCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return programs.size();
+}
+
+void ProgramCache::writeMetrics(std::ostream& out) const {
+    out << "# HELP csopesy_program_cache_programs Parsed program files held in the cache.\n";
+    out << "# TYPE csopesy_program_cache_programs gauge\n";
+    out << "csopesy_program_cache_programs " << size() << "\n";
+    out << "# HELP csopesy_program_cache_hits_total Program launches that reused a cached parse.\n";
+    out << "# TYPE csopesy_program_cache_hits_total counter\n";
+    out << "csopesy_program_cache_hits_total " << getHits() << "\n";
+    out << "# HELP csopesy_program_cache_misses_total Program files parsed because no cached copy matched.\n";
+    out << "# TYPE csopesy_program_cache_misses_total counter\n";
+    out << "csopesy_program_cache_misses_total " << getMisses() << "\n";
+}
@@ -0,0 +1,57 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Instruction;
+
+// FOR bodies may nest this deep
+constexpr int MAX_FOR_NESTING = 3;
+
+// A parsed program file. Instructions keep no per-process state, so every process
+// launched from the same file runs the same instruction objects.
+struct Program {
+    uint64_t hash = 0;
+    std::string source;
+    std::vector<std::shared_ptr<Instruction>> instructions;
+};
+
+// Parses program text: DECLARE(var, value), ADD/SUBTRACT(var, a, b), PRINT("text" + var),
+// SLEEP(ms), FOR([body], repeats), READ(var, address) and WRITE(address, value), separated
+// by newlines or ';'. Returns false with error set to "line N: ..." on the first mistake.
+bool parseProgram(const std::string& source, std::vector<std::shared_ptr<Instruction>>& instructions, std::string& error);
+
+// Compiled programs keyed by a hash of the file contents, so an edited file is parsed
+// again while any number of launches of an unchanged one share the first parse
+class ProgramCache {
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const Program>> programs;
+    std::atomic<uint64_t> hits{ 0 };
+    std::atomic<uint64_t> misses{ 0 };
+
+    ProgramCache() = default;
+
+public:
+    static ProgramCache& getInstance();
+
+    ProgramCache(const ProgramCache&) = delete;
+    ProgramCache& operator=(const ProgramCache&) = delete;
+
+    // Returns null with error set if the file cannot be read or does not parse
+    std::shared_ptr<const Program> load(const std::string& filename, std::string& error);
+
+    size_t size() const;
+    uint64_t getHits() const { return hits.load(); }
+    uint64_t getMisses() const { return misses.load(); }
+    void writeMetrics(std::ostream& out) const;
+};
+
+#endif // PROGRAMCACHE_H
@@ -0,0 +1,34 @@
+#include "ReadInstruction.h"
+#include "Checkpoint.h"
+#include "MemoryManager.h"
+#include "process.h"
+#include "utils.h"
+#include <sstream>
+
+ReadInstruction::ReadInstruction(const std::string& varName, size_t address, const std::string& logPrefix)
+    : variableName(varName), address(address), logPrefix(logPrefix) {
+}
+
+// An out-of-range address throws AccessViolation before the variable is touched
+void ReadInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
+    uint16_t value = MemoryManager::getInstance().read(*proc, coreId, address);
+    proc->memory[variableName] = value;
+
+    std::ostringstream logEntry;
+    logEntry << "[" << getCurrentTimestamp() << "] "
+        << "Core " << coreId << " | PID " << proc->pid
+        << " | READ: " << variableName << " = " << value << " from 0x" << std::hex << std::uppercase << address;
+    proc->logs.push_back(logEntry.str());
+    logToFile(proc->name, logEntry.str(), coreId);
+}
+
+void ReadInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::READ));
+    out.putString(variableName);
+    out.putU32(static_cast<uint32_t>(address));
+    out.putString(logPrefix);
+}
+
+Opcode ReadInstruction::opcode() const {
+    return Opcode::READ;
+}
@@ -0,0 +1,23 @@
+#ifndef READINSTRUCTION_H
+#define READINSTRUCTION_H
+
+#include "Instruction.h"
+#include <string>
+#include <memory>
+#include <cstddef>
+
+// READ var, address: loads the 16-bit value at address in the process's memory region into var
+class ReadInstruction : public Instruction {
+public:
+    std::string variableName;
+    size_t address;
+    std::string logPrefix = "";
+
+    ReadInstruction(const std::string& varName, size_t address, const std::string& logPrefix = "");
+
+    void execute(std::shared_ptr<Process> proc, int coreId = -1) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
+};
+
+#endif // READINSTRUCTION_H
@@ -1,4 +1,5 @@
 #include "SleepInstruction.h"
+#include "Checkpoint.h"
 #include "process.h"
 #include "utils.h"
 #include <sstream>
@@ -15,3 +16,13 @@ void SleepInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
     proc->logs.push_back(logEntry.str());
     logToFile(proc->name, logEntry.str(), coreId);
 }
+
+void SleepInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::SLEEP));
+    out.putI32(duration);
+    out.putString(logPrefix);
+}
+
+Opcode SleepInstruction::opcode() const {
+    return Opcode::SLEEP;
+}
@@ -1,5 +1,5 @@
 #pragma once
-#include "instruction.h"
+#include "Instruction.h"
 #include "process.h"
 #include <memory>
 
@@ -12,6 +12,8 @@ public:
     std::string logPrefix = "";
     SleepInstruction(int ms, const std::string& logPrefix = "");
     void execute(std::shared_ptr<Process> proc, int coreId = -1) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
 
     int getDuration() const { return duration; }
 };
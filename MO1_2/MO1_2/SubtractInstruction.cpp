@@ -1,4 +1,5 @@
 ﻿#include "SubtractInstruction.h"
+#include "Checkpoint.h"
 #include "process.h"
 #include "utils.h"
 #include <sstream>
@@ -21,3 +22,15 @@ void SubtractInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
     proc->logs.push_back(logEntry.str());
     logToFile(proc->name, logEntry.str(), coreId);
 }
+
+void SubtractInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::SUBTRACT));
+    out.putString(resultVar);
+    out.putString(arg1);
+    out.putString(arg2);
+    out.putString(logPrefix);
+}
+
+Opcode SubtractInstruction::opcode() const {
+    return Opcode::SUBTRACT;
+}
@@ -1,7 +1,7 @@
 #ifndef SUBTRACTINSTRUCTION_H
 #define SUBTRACTINSTRUCTION_H
 
-#include "instruction.h"
+#include "Instruction.h"
 #include <string>
 #include <memory>
 
@@ -15,6 +15,8 @@ public:
     SubtractInstruction(const std::string& result, const std::string& lhs, const std::string& rhs, const std::string& logPrefix = "");
 
     void execute(std::shared_ptr<Process> proc, int coreId = -1) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
 };
 
 #endif 
@@ -0,0 +1,138 @@
+#include "Timeline.h"
+#include "scheduler.h"
+#include "ProcessManager.h"
+#include "ProcessArchive.h"
+#include "utils.h"
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <unordered_map>
+
+namespace {
+    const int TICK_BUFFER = MAX_CORES;
+    const int TRACE_PID = 1;
+
+    // Chrome timestamps are microseconds
+    void writeMicros(std::ostream& out, int64_t ns) {
+        out << ns / 1000 << "." << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+    }
+}
+
+Timeline::Timeline() : buffers(new Buffer[MAX_CORES + 1]) {}
+
+Timeline& Timeline::getInstance() {
+    static Timeline instance;
+    return instance;
+}
+
+void Timeline::begin(const std::string& file) {
+    active = false;
+    for (int i = 0; i <= MAX_CORES; ++i) {
+        buffers[i].events.clear();
+        buffers[i].dropped = 0;
+    }
+    filename = file;
+    origin = std::chrono::steady_clock::now();
+    active = !file.empty();
+}
+
+int64_t Timeline::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void Timeline::record(int core, TimelineKind kind, int pid, int64_t startNs, int value, const char* reason) {
+    // Any other id has no buffer of its own; sharing one would break the single-writer rule
+    if (!isActive() || core < -1 || core >= MAX_CORES) return;
+    Buffer& buffer = buffers[core < 0 ? TICK_BUFFER : core];
+    if (buffer.events.size() >= MAX_EVENTS_PER_BUFFER) {
+        buffer.dropped++;
+        return;
+    }
+    TimelineEvent event;
+    event.kind = kind;
+    event.startNs = startNs;
+    event.durationNs = kind == TimelineKind::QUEUE_DEPTH ? 0 : now() - startNs;
+    event.pid = pid;
+    event.value = value;
+    event.reason = reason;
+    buffer.events.push_back(event);
+}
+
+void Timeline::finish() {
+    if (!active.exchange(false)) return;
+
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cout << "Could not write timeline to " << filename << "\n";
+        return;
+    }
+
+    std::unordered_map<int, std::string> names;
+    for (const auto& record : ProcessArchive::getInstance().getRecords()) names[record.pid] = record.name;
+    for (const auto& process : ProcessManager::getAllProcesses()) names[process->pid] = process->name;
+    auto nameOf = [&names](int pid) {
+        auto found = names.find(pid);
+        return found == names.end() ? "pid " + std::to_string(pid) : found->second;
+    };
+
+    size_t written = 0;
+    uint64_t dropped = 0;
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << TRACE_PID << ", \"args\": {\"name\": \"CSOPESY\"}}";
+    for (int i = 0; i <= MAX_CORES; ++i) {
+        const Buffer& buffer = buffers[i];
+        dropped += buffer.dropped;
+        if (buffer.events.empty()) continue;
+        out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << TRACE_PID << ", \"tid\": " << i
+            << ", \"args\": {\"name\": " << jsonString(i == TICK_BUFFER ? "Scheduler" : "Core " + std::to_string(i)) << "}}";
+        out << ",\n{\"name\": \"thread_sort_index\", \"ph\": \"M\", \"pid\": " << TRACE_PID << ", \"tid\": " << i
+            << ", \"args\": {\"sort_index\": " << i << "}}";
+
+        for (const auto& event : buffer.events) {
+            out << ",\n{";
+            switch (event.kind) {
+            case TimelineKind::RUN:
+                out << "\"name\": " << jsonString(nameOf(event.pid)) << ", \"cat\": \"run\", \"ph\": \"X\"";
+                break;
+            case TimelineKind::SLEEP:
+                out << "\"name\": \"SLEEP\", \"cat\": \"sleep\", \"ph\": \"X\"";
+                break;
+            case TimelineKind::ALLOC_FAIL:
+                out << "\"name\": \"alloc-fail\", \"cat\": \"memory\", \"ph\": \"X\"";
+                break;
+            case TimelineKind::QUEUE_DEPTH:
+                out << "\"name\": \"ready queue\", \"ph\": \"C\"";
+                break;
+            }
+            out << ", \"ts\": ";
+            writeMicros(out, event.startNs);
+            if (event.kind != TimelineKind::QUEUE_DEPTH) {
+                out << ", \"dur\": ";
+                writeMicros(out, event.durationNs);
+            }
+            out << ", \"pid\": " << TRACE_PID << ", \"tid\": " << i << ", \"args\": {";
+            switch (event.kind) {
+            case TimelineKind::RUN:
+                out << "\"pid\": " << event.pid << ", \"instructions\": " << event.value
+                    << ", \"end\": " << jsonString(event.reason ? event.reason : "");
+                break;
+            case TimelineKind::SLEEP:
+                out << "\"pid\": " << event.pid << ", \"ms\": " << event.value;
+                break;
+            case TimelineKind::ALLOC_FAIL:
+                out << "\"pid\": " << event.pid << ", \"bytes\": " << event.value;
+                break;
+            case TimelineKind::QUEUE_DEPTH:
+                out << "\"depth\": " << event.value;
+                break;
+            }
+            out << "}}";
+            written++;
+        }
+    }
+    out << "\n]}\n";
+
+    std::cout << "Timeline written to " << filename << ": " << written << " events";
+    if (dropped > 0) std::cout << " (" << dropped << " dropped, buffer full)";
+    std::cout << "\n";
+}
@@ -0,0 +1,64 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class TimelineKind : uint8_t {
+    RUN,          // one dispatch of a process on a core; value = instructions executed
+    SLEEP,        // a SLEEP instruction and its delay; value = requested ms
+    ALLOC_FAIL,   // no memory for the dispatched process, until the core retries; value = bytes
+    QUEUE_DEPTH   // ready-queue length sampled by the tick thread; value = depth
+};
+
+struct TimelineEvent {
+    TimelineKind kind = TimelineKind::RUN;
+    int64_t startNs = 0;
+    int64_t durationNs = 0;
+    int pid = -1;
+    int value = 0;
+    const char* reason = nullptr;  // RUN: why the dispatch ended (static string)
+};
+
+// Chrome trace-event export of per-core scheduling activity (timeline-file in
+// config.txt). Each emulated core appends only to its own buffer and the tick thread
+// to one more, so recording takes no lock. The buffers are read once, by write(),
+// after every recording thread has been joined.
+class Timeline {
+public:
+    static constexpr size_t MAX_EVENTS_PER_BUFFER = 1 << 20;
+
+    static Timeline& getInstance();
+
+    Timeline(const Timeline&) = delete;
+    Timeline& operator=(const Timeline&) = delete;
+
+    // Clears the buffers and starts recording if filename is not empty
+    void begin(const std::string& filename);
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+    int64_t now() const;
+
+    // core = -1 records on the tick thread's buffer; ids outside 0..MAX_CORES-1 are ignored
+    void record(int core, TimelineKind kind, int pid, int64_t startNs, int value, const char* reason = nullptr);
+    // Stops recording and writes the JSON file; a no-op when recording was never started
+    void finish();
+
+private:
+    Timeline();
+
+    struct alignas(64) Buffer {
+        std::vector<TimelineEvent> events;
+        uint64_t dropped = 0;
+    };
+
+    std::atomic<bool> active{ false };
+    std::string filename;
+    std::chrono::steady_clock::time_point origin;
+    std::unique_ptr<Buffer[]> buffers;  // MAX_CORES core buffers, then the tick thread's
+};
+
+#endif // TIMELINE_H
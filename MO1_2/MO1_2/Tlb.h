@@ -0,0 +1,75 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Software TLB for one emulated core: caches virtual page -> physical frame address
+// for the process currently on the core. Fully associative with round-robin
+// replacement. Entries carry no address-space tag, so the whole TLB is flushed
+// whenever a different process is dispatched onto the core. Only the owning core
+// touches the entries; the counters are atomics so reports can read them.
+class alignas(64) SoftwareTlb {
+public:
+    static constexpr int ENTRIES = 16;
+
+    bool lookup(size_t page, size_t& frame) {
+        return lookup(page, frame, [](size_t) { return true; });
+    }
+
+    // isValid(frame) lets the caller reject an entry whose frame has been reassigned
+    // since it was cached (paging evictions by other cores); the entry is dropped and
+    // the access counts as a miss
+    template <typename Valid>
+    bool lookup(size_t page, size_t& frame, Valid isValid) {
+        for (auto& entry : entries) {
+            if (entry.valid && entry.page == page) {
+                if (!isValid(entry.frame)) {
+                    entry.valid = false;
+                    break;
+                }
+                frame = entry.frame;
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void insert(size_t page, size_t frame) {
+        entries[victim] = { page, frame, true };
+        victim = (victim + 1) % ENTRIES;
+    }
+
+    // Context switch: drop every mapping unless the same process is coming back
+    void switchTo(int pid) {
+        if (pid == owner) return;
+        owner = pid;
+        for (auto& entry : entries) entry.valid = false;
+        victim = 0;
+        flushes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+    uint64_t getFlushes() const { return flushes.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        size_t page = 0;
+        size_t frame = 0;
+        bool valid = false;
+    };
+
+    std::array<Entry, ENTRIES> entries{};
+    int victim = 0;
+    int owner = -1;
+    std::atomic<uint64_t> hits{ 0 };
+    std::atomic<uint64_t> misses{ 0 };
+    std::atomic<uint64_t> flushes{ 0 };
+};
+
+#endif // TLB_H
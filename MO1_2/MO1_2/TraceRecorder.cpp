@@ -0,0 +1,256 @@
+#include "TraceRecorder.h"
+#include "config.h"
+#include "scheduler.h"
+#include "ProcessManager.h"
+#include <iostream>
+#include <algorithm>
+
+namespace {
+    const char TRACE_MAGIC[4] = { 'C', 'S', 'T', 'R' };
+    const uint16_t TRACE_VERSION = 2;
+
+    void putU8(std::vector<char>& buf, uint8_t v) { buf.push_back(static_cast<char>(v)); }
+    void putU16(std::vector<char>& buf, uint16_t v) {
+        buf.push_back(static_cast<char>(v & 0xFF));
+        buf.push_back(static_cast<char>((v >> 8) & 0xFF));
+    }
+    void putU32(std::vector<char>& buf, uint32_t v) {
+        for (int i = 0; i < 4; ++i) buf.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    bool getU8(std::istream& in, uint8_t& v) {
+        char c;
+        if (!in.get(c)) return false;
+        v = static_cast<uint8_t>(c);
+        return true;
+    }
+    bool getU16(std::istream& in, uint16_t& v) {
+        unsigned char b[2];
+        if (!in.read(reinterpret_cast<char*>(b), 2)) return false;
+        v = static_cast<uint16_t>(b[0] | (b[1] << 8));
+        return true;
+    }
+    bool getU32(std::istream& in, uint32_t& v) {
+        unsigned char b[4];
+        if (!in.read(reinterpret_cast<char*>(b), 4)) return false;
+        v = static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+            (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+        return true;
+    }
+}
+
+TraceRecorder& TraceRecorder::getInstance() {
+    static TraceRecorder instance;
+    return instance;
+}
+
+bool TraceRecorder::start(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (active.load()) return false;
+
+    out.open(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    const auto& config = Config::getInstance();
+    std::string sched = config.scheduler;
+    std::transform(sched.begin(), sched.end(), sched.begin(), ::toupper);
+
+    buffer.clear();
+    buffer.insert(buffer.end(), TRACE_MAGIC, TRACE_MAGIC + 4);
+    putU16(buffer, TRACE_VERSION);
+    putU16(buffer, static_cast<uint16_t>(config.numCPU));
+    putU8(buffer, (sched == "RR" || sched == "ROUND_ROBIN") ? 1 : 0);
+    putU8(buffer, 0);
+    putU32(buffer, static_cast<uint32_t>(config.quantumCycles));
+    putU32(buffer, static_cast<uint32_t>(config.minInstructions));
+    putU32(buffer, static_cast<uint32_t>(config.maxInstructions));
+    putU32(buffer, static_cast<uint32_t>(config.memPerProc));
+    putU32(buffer, static_cast<uint32_t>(config.delayPerInstruction));
+
+    eventCount = 0;
+    active = true;
+    return true;
+}
+
+size_t TraceRecorder::stop() {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (!active.load()) return 0;
+    active = false;
+    flushLocked();
+    out.close();
+    return eventCount;
+}
+
+void TraceRecorder::flushLocked() {
+    if (buffer.empty()) return;
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+void TraceRecorder::record(TraceEventType type, int core, int pid, uint32_t arg, const std::string& name,
+    uint32_t instructions, uint32_t memory) {
+    if (!active.load(std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (!active.load()) return;
+
+    putU32(buffer, static_cast<uint32_t>(cpuTick.load()));
+    putU8(buffer, static_cast<uint8_t>(type));
+    putU8(buffer, core < 0 ? 0xFF : static_cast<uint8_t>(core));
+    putU16(buffer, static_cast<uint16_t>(name.size()));
+    putU32(buffer, static_cast<uint32_t>(pid));
+    putU32(buffer, arg);
+    buffer.insert(buffer.end(), name.begin(), name.end());
+    if (type == TraceEventType::ARRIVAL) {
+        putU32(buffer, instructions);
+        putU32(buffer, memory);
+    }
+    eventCount++;
+
+    if (buffer.size() >= 64 * 1024) flushLocked();
+}
+
+bool TraceReplayer::load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    char magic[4];
+    uint16_t version = 0, numCPU = 0;
+    uint8_t rr = 0, pad = 0;
+    uint32_t quantum = 0, minIns = 0, maxIns = 0, memPerProc = 0, delay = 0;
+    if (!in.read(magic, 4) || !std::equal(magic, magic + 4, TRACE_MAGIC)) return false;
+    if (!getU16(in, version) || version < 1 || version > TRACE_VERSION) return false;
+    if (!getU16(in, numCPU) || !getU8(in, rr) || !getU8(in, pad)) return false;
+    if (!getU32(in, quantum) || !getU32(in, minIns) || !getU32(in, maxIns) ||
+        !getU32(in, memPerProc) || !getU32(in, delay)) return false;
+
+    header.numCPU = numCPU;
+    header.roundRobin = rr != 0;
+    header.quantum = static_cast<int>(quantum);
+    header.minIns = static_cast<int>(minIns);
+    header.maxIns = static_cast<int>(maxIns);
+    header.memPerProc = memPerProc;
+    header.delay = static_cast<int>(delay);
+
+    events.clear();
+    while (true) {
+        TraceEvent ev;
+        uint8_t type = 0, core = 0;
+        uint16_t nameLen = 0;
+        uint32_t pid = 0;
+        if (!getU32(in, ev.tick)) break;
+        if (!getU8(in, type) || !getU8(in, core) || !getU16(in, nameLen) ||
+            !getU32(in, pid) || !getU32(in, ev.arg)) return false;
+        ev.type = static_cast<TraceEventType>(type);
+        ev.core = core == 0xFF ? -1 : core;
+        ev.pid = static_cast<int>(pid);
+        if (nameLen > 0) {
+            ev.name.resize(nameLen);
+            if (!in.read(&ev.name[0], nameLen)) return false;
+        }
+        if (ev.type == TraceEventType::ARRIVAL && version >= 2) {
+            if (!getU32(in, ev.instructions) || !getU32(in, ev.memory)) return false;
+        }
+        events.push_back(std::move(ev));
+    }
+
+    cursor = 0;
+    divergences = 0;
+    aborted = false;
+    return true;
+}
+
+int TraceReplayer::awaitDispatch(int coreId) {
+    std::unique_lock<std::mutex> lock(cursorMutex);
+    while (true) {
+        if (aborted || cursor >= events.size()) return -1;
+        const auto& ev = events[cursor];
+        if (ev.core == coreId) {
+            if (ev.type == TraceEventType::DISPATCH) return ev.pid;
+            // This core is idle but the trace expects it to be executing something
+            divergences++;
+            aborted = true;
+            cursorCV.notify_all();
+            return -1;
+        }
+        cursorCV.wait(lock);
+    }
+}
+
+bool TraceReplayer::awaitTurn(TraceEventType type, int coreId, int pid) {
+    std::unique_lock<std::mutex> lock(cursorMutex);
+    while (true) {
+        if (aborted || cursor >= events.size()) return false;
+        const auto& ev = events[cursor];
+        bool sameType = ev.type == type ||
+            (type == TraceEventType::ALLOC && ev.type == TraceEventType::ALLOC_FAIL);
+        if (sameType && ev.core == coreId && ev.pid == pid) return true;
+        if (coreId >= 0 && ev.core == coreId) {
+            divergences++;
+            aborted = true;
+            cursorCV.notify_all();
+            return false;
+        }
+        cursorCV.wait(lock);
+    }
+}
+
+void TraceReplayer::advance() {
+    {
+        std::lock_guard<std::mutex> lock(cursorMutex);
+        if (cursor < events.size()) cursor++;
+    }
+    cursorCV.notify_all();
+}
+
+void TraceReplayer::checkAllocation(int pid, bool success) {
+    std::lock_guard<std::mutex> lock(cursorMutex);
+    if (cursor >= events.size()) return;
+    const auto& ev = events[cursor];
+    bool recorded = ev.type == TraceEventType::ALLOC;
+    if (ev.pid != pid || recorded != success) divergences++;
+}
+
+void TraceReplayer::abort() {
+    {
+        std::lock_guard<std::mutex> lock(cursorMutex);
+        aborted = true;
+    }
+    cursorCV.notify_all();
+}
+
+bool TraceReplayer::finished() {
+    std::lock_guard<std::mutex> lock(cursorMutex);
+    return aborted || cursor >= events.size();
+}
+
+void TraceReplayer::driveArrivals() {
+    while (true) {
+        TraceEvent ev;
+        {
+            std::unique_lock<std::mutex> lock(cursorMutex);
+            cursorCV.wait(lock, [this] {
+                return aborted || cursor >= events.size() || events[cursor].type == TraceEventType::ARRIVAL;
+                });
+            if (aborted || cursor >= events.size()) break;
+            ev = events[cursor];
+        }
+
+        // Version 2 traces carry the drawn size, so any workload distribution replays exactly
+        auto proc = ev.instructions > 0
+            ? ProcessManager::createProcess(ev.name, ev.pid, ev.instructions, ev.instructions, ev.memory, ev.arg)
+            : ProcessManager::createProcess(ev.name, ev.pid, header.minIns, header.maxIns, header.memPerProc, ev.arg);
+        ProcessManager::addProcess(proc);
+        addProcess(proc);
+        advance();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cursorMutex);
+        bool diverged = aborted && cursor < events.size();
+        std::cout << "\n[REPLAY] " << (diverged ? "Diverged" : "Finished") << " after " << cursor
+            << " / " << events.size() << " events (" << divergences << " divergences).\n> ";
+        std::cout.flush();
+    }
+    stopScheduler();
+}
@@ -0,0 +1,109 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <fstream>
+#include <cstdint>
+
+// Binary trace layout (little endian):
+//   header : "CSTR" u16 version, u16 numCPU, u8 scheduler, u8 pad,
+//            u32 quantum, u32 minIns, u32 maxIns, u32 memPerProc, u32 delay
+//   event  : u32 tick, u8 type, u8 core (0xFF = none), u16 nameLen, i32 pid, u32 arg
+//            followed by nameLen bytes (only ARRIVAL carries a name)
+//            ARRIVAL then appends u32 instructions, u32 memory (version 2+)
+enum class TraceEventType : uint8_t {
+    ARRIVAL = 1,     // arg = generation seed
+    DISPATCH = 2,    // arg = instruction pointer
+    ALLOC = 3,       // arg = base address
+    ALLOC_FAIL = 4,  // arg = requested bytes
+    REQUEUE = 5,     // arg = instruction pointer (memory allocation failed)
+    PREEMPT = 6,     // arg = instruction pointer
+    COMPLETE = 7,    // arg = completed instructions
+    FREE = 8         // arg = base address
+};
+
+struct TraceEvent {
+    uint32_t tick = 0;
+    TraceEventType type = TraceEventType::ARRIVAL;
+    int core = -1;
+    int pid = -1;
+    uint32_t arg = 0;
+    std::string name;
+    uint32_t instructions = 0;  // ARRIVAL only; 0 in version 1 traces
+    uint32_t memory = 0;
+};
+
+struct TraceHeader {
+    int numCPU = 0;
+    bool roundRobin = true;
+    int quantum = 0;
+    int minIns = 0;
+    int maxIns = 0;
+    uint32_t memPerProc = 0;
+    int delay = 0;
+};
+
+class TraceRecorder {
+private:
+    TraceRecorder() = default;
+
+    std::atomic<bool> active{ false };
+    std::mutex traceMutex;
+    std::ofstream out;
+    std::vector<char> buffer;
+    size_t eventCount = 0;
+
+    void flushLocked();
+
+public:
+    static TraceRecorder& getInstance();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    bool start(const std::string& filename);
+    size_t stop();
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+    void record(TraceEventType type, int core, int pid, uint32_t arg, const std::string& name = "",
+        uint32_t instructions = 0, uint32_t memory = 0);
+};
+
+// Re-drives the scheduler from a recorded trace. Every recorded event changes
+// ready-queue order or memory state, so each one is sequenced: the thread that
+// reaches it blocks until the trace cursor points at the same event, and cores
+// dispatch, allocate, requeue, preempt and free in exactly the recorded order.
+class TraceReplayer {
+private:
+    std::vector<TraceEvent> events;
+    TraceHeader header;
+    size_t cursor = 0;
+    size_t divergences = 0;
+    bool aborted = false;
+    std::mutex cursorMutex;
+    std::condition_variable cursorCV;
+
+public:
+    bool load(const std::string& filename);
+    const TraceHeader& getHeader() const { return header; }
+    size_t getEventCount() const { return events.size(); }
+    size_t getDivergences() const { return divergences; }
+
+    // Blocks until the next sequenced event is a dispatch for this core; returns its pid or -1 when done.
+    int awaitDispatch(int coreId);
+    // Blocks until the next sequenced event matches, returns false if the replay ended or diverged.
+    bool awaitTurn(TraceEventType type, int coreId, int pid);
+    void advance();
+    void checkAllocation(int pid, bool success);
+    void abort();
+    bool finished();
+
+    // Feeds recorded arrivals into the global scheduler in trace order.
+    void driveArrivals();
+};
+
+#endif // TRACE_RECORDER_H
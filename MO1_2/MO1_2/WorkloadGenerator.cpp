@@ -0,0 +1,215 @@
+#include "WorkloadGenerator.h"
+#include "ProcessManager.h"
+#include "scheduler.h"
+#include "MemoryManager.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+WorkloadGenerator::~WorkloadGenerator() {
+    stop();
+}
+
+bool WorkloadGenerator::configure(const Config& config) {
+    std::string arrival = config.arrivalMode;
+    std::transform(arrival.begin(), arrival.end(), arrival.begin(), ::tolower);
+
+    if (arrival == "fixed") mode = ArrivalMode::FIXED;
+    else if (arrival == "poisson") mode = ArrivalMode::POISSON;
+    else if (arrival == "bursty") mode = ArrivalMode::BURSTY;
+    else if (arrival == "trace") mode = ArrivalMode::TRACE;
+    else {
+        std::cout << "Unknown arrival-mode: " << config.arrivalMode << " (use fixed, poisson, bursty or trace)\n";
+        return false;
+    }
+
+    interval = std::max(config.batchProcessFreq, 1);
+    rate = config.arrivalRate > 0 ? config.arrivalRate : 1.0 / interval;
+    burstOn = std::max(config.burstOn, 1);
+    burstOff = std::max(config.burstOff, 0);
+    batchSize = std::max(config.batchSize, 1);
+
+    minIns = std::max(config.minInstructions, 1);
+    maxIns = std::max(config.maxInstructions, minIns);
+    insDist = config.insDist;
+    if (insDist != "uniform" && insDist != "exponential" && insDist != "normal") {
+        std::cout << "Unknown ins-dist: " << insDist << " (use uniform, exponential or normal)\n";
+        return false;
+    }
+
+    minMem = config.minMemPerProc > 0 ? config.minMemPerProc : config.memPerProc;
+    maxMem = config.maxMemPerProc > 0 ? config.maxMemPerProc : std::max(minMem, config.memPerProc);
+    if (maxMem < minMem) std::swap(minMem, maxMem);
+    memDist = config.memDist;
+    if (memDist != "fixed" && memDist != "uniform" && memDist != "pow2") {
+        std::cout << "Unknown mem-dist: " << memDist << " (use fixed, uniform or pow2)\n";
+        return false;
+    }
+
+    std::string policy = config.admissionPolicy;
+    std::transform(policy.begin(), policy.end(), policy.begin(), ::tolower);
+    if (policy != "defer" && policy != "reject") {
+        std::cout << "Unknown admission-policy: " << config.admissionPolicy << " (use defer or reject)\n";
+        return false;
+    }
+    rejectOverflow = policy == "reject";
+    maxInFlight = std::max(config.maxInFlight, 0);
+    queueHigh = std::max(config.queueHighWatermark, 0);
+    queueLow = config.queueLowWatermark > 0 ? std::min(config.queueLowWatermark, queueHigh) : queueHigh / 2;
+    freeMemLow = config.freeMemLowWatermark;
+    freeMemHigh = std::max(config.freeMemHighWatermark, freeMemLow);
+    paused = false;
+    backlog = 0;
+
+    // Own stream, distinct from the per-process seeds, so a seeded run reproduces the arrival pattern too
+    gen.seed(config.seed != 0 ? config.seed * 2654435761u : std::random_device{}());
+
+    traceArrivals.clear();
+    if (mode == ArrivalMode::TRACE && !loadTrace(config.arrivalTrace)) {
+        std::cout << "Could not read arrival-trace: " << config.arrivalTrace << "\n";
+        return false;
+    }
+    return true;
+}
+
+// One "<tick> [count]" pair per line, ticks counted from scheduler start; '#' starts a comment
+bool WorkloadGenerator::loadTrace(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line.substr(0, line.find('#')));
+        int tick = 0, count = 1;
+        if (!(iss >> tick)) continue;
+        iss >> count;
+        if (tick > 0 && count > 0) traceArrivals[tick] += count;
+    }
+    return !traceArrivals.empty();
+}
+
+void WorkloadGenerator::start() {
+    if (active.load()) return;
+    active = true;
+    worker = std::thread(&WorkloadGenerator::run, this);
+}
+
+void WorkloadGenerator::stop() {
+    active = false;
+    if (worker.joinable()) worker.join();
+}
+
+void WorkloadGenerator::run() {
+    int lastTick = getSchedulerStartTick();
+
+    while (active.load()) {
+        // Catch up on every tick since the last pass so no arrival is lost to scheduling jitter
+        int now = cpuTick.load();
+        for (int tick = lastTick + 1; tick <= now && active.load(); ++tick) {
+            long long arrived = static_cast<long long>(arrivalsAt(tick)) * batchSize;
+            long long waiting = backlog + arrived;
+
+            // Older deferred arrivals go first; whatever is left over this tick is deferred or dropped
+            long long admitted = 0;
+            while (admitted < waiting && active.load() && admitOne()) {
+                submitProcess();
+                admitted++;
+            }
+            long long leftover = waiting - admitted;
+            long long newlyHeld = std::min(leftover, arrived);
+
+            if (rejectOverflow) {
+                backlog = 0;
+                recordAdmission(0, static_cast<uint64_t>(leftover), paused);
+            }
+            else {
+                backlog = leftover;
+                recordAdmission(static_cast<uint64_t>(newlyHeld), 0, paused);
+            }
+        }
+        lastTick = std::max(lastTick, now);
+
+        if (mode == ArrivalMode::TRACE && backlog == 0 && lastTick >= traceArrivals.rbegin()->first) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+// Applies the in-flight limit and the queue/free-memory watermarks. The watermarks
+// have hysteresis: generation pauses at the high queue depth (or low free memory)
+// and only resumes once the queue has drained to the low mark and memory recovered.
+bool WorkloadGenerator::admitOne() {
+    if (maxInFlight > 0 && getProcessesInFlight() >= static_cast<uint64_t>(maxInFlight)) return false;
+
+    int depth = getReadyDepth();
+    size_t freeMem = MemoryManager::getInstance().getFreeBytes();
+    if (!paused) {
+        paused = (queueHigh > 0 && depth >= queueHigh) || (freeMemLow > 0 && freeMem < freeMemLow);
+    }
+    else {
+        bool queueDrained = queueHigh == 0 || depth <= queueLow;
+        bool memoryRecovered = freeMemLow == 0 || freeMem >= freeMemHigh;
+        paused = !(queueDrained && memoryRecovered);
+    }
+    return !paused;
+}
+
+void WorkloadGenerator::submitProcess() {
+    int instructions = drawInstructions();
+    auto proc = ProcessManager::createUniqueNamedProcess(instructions, instructions, drawMemory());
+    ProcessManager::addProcess(proc);
+    addProcess(proc);
+}
+
+int WorkloadGenerator::arrivalsAt(int tick) {
+    switch (mode) {
+    case ArrivalMode::FIXED:
+        return (tick - 1) % interval == 0 ? 1 : 0;
+    case ArrivalMode::POISSON:
+        return std::poisson_distribution<int>(rate)(gen);
+    case ArrivalMode::BURSTY: {
+        int phase = (tick - 1) % (burstOn + burstOff);
+        return (phase < burstOn && phase % interval == 0) ? 1 : 0;
+    }
+    case ArrivalMode::TRACE: {
+        auto it = traceArrivals.find(tick);
+        return it != traceArrivals.end() ? it->second : 0;
+    }
+    }
+    return 0;
+}
+
+int WorkloadGenerator::drawInstructions() {
+    double value;
+    if (insDist == "exponential") {
+        // Long tail above min-ins with the same mean as the uniform range
+        double mean = (maxIns - minIns) / 2.0;
+        value = minIns + (mean > 0 ? std::exponential_distribution<double>(1.0 / mean)(gen) : 0.0);
+    }
+    else if (insDist == "normal") {
+        double sd = (maxIns - minIns) / 6.0;
+        value = sd > 0 ? std::normal_distribution<double>((minIns + maxIns) / 2.0, sd)(gen) : minIns;
+    }
+    else {
+        return std::uniform_int_distribution<int>(minIns, maxIns)(gen);
+    }
+    return std::clamp(static_cast<int>(std::lround(value)), minIns, maxIns);
+}
+
+size_t WorkloadGenerator::drawMemory() {
+    if (memDist == "uniform") {
+        return std::uniform_int_distribution<size_t>(minMem, maxMem)(gen);
+    }
+    if (memDist == "pow2") {
+        std::vector<size_t> sizes;
+        for (size_t size = 1; size <= maxMem && size != 0; size <<= 1) {
+            if (size >= minMem) sizes.push_back(size);
+        }
+        if (sizes.empty()) return minMem;
+        return sizes[std::uniform_int_distribution<size_t>(0, sizes.size() - 1)(gen)];
+    }
+    return minMem;
+}
@@ -0,0 +1,73 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include "config.h"
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <atomic>
+
+enum class ArrivalMode {
+    FIXED,    // one arrival every batch-process-freq ticks
+    POISSON,  // Poisson-distributed arrivals per tick at arrival-rate
+    BURSTY,   // fixed-rate arrivals for burst-on ticks, then burst-off ticks of silence
+    TRACE     // arrivals at the ticks listed in arrival-trace
+};
+
+// Feeds the scheduler on its own clock. Every tick yields some number of arrivals
+// according to the arrival mode, and each arrival creates batch-size processes whose
+// instruction count and memory size are drawn from the configured distributions.
+class WorkloadGenerator {
+private:
+    ArrivalMode mode = ArrivalMode::FIXED;
+    int interval = 1;
+    double rate = 1.0;
+    int burstOn = 10;
+    int burstOff = 10;
+    int batchSize = 1;
+    int minIns = 1;
+    int maxIns = 1;
+    std::string insDist;
+    size_t minMem = 0;
+    size_t maxMem = 0;
+    std::string memDist;
+    std::map<int, int> traceArrivals;  // tick -> arrivals
+
+    // Admission control
+    int maxInFlight = 0;
+    int queueHigh = 0;
+    int queueLow = 0;
+    size_t freeMemLow = 0;
+    size_t freeMemHigh = 0;
+    bool rejectOverflow = false;
+    bool paused = false;
+    long long backlog = 0;  // deferred processes not yet created
+    std::mt19937 gen;
+
+    std::thread worker;
+    std::atomic<bool> active{ false };
+
+    void run();
+    int arrivalsAt(int tick);
+    bool admitOne();
+    void submitProcess();
+    int drawInstructions();
+    size_t drawMemory();
+    bool loadTrace(const std::string& path);
+
+public:
+    WorkloadGenerator() = default;
+    ~WorkloadGenerator();
+
+    WorkloadGenerator(const WorkloadGenerator&) = delete;
+    WorkloadGenerator& operator=(const WorkloadGenerator&) = delete;
+
+    // Reads the workload settings; prints the problem and returns false if they are unusable
+    bool configure(const Config& config);
+    void start();
+    void stop();
+    bool isActive() const { return active.load(); }
+};
+
+#endif // WORKLOAD_GENERATOR_H
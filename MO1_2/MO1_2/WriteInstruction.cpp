@@ -0,0 +1,39 @@
+#include "WriteInstruction.h"
+#include "Checkpoint.h"
+#include "MemoryManager.h"
+#include "process.h"
+#include "utils.h"
+#include <sstream>
+
+WriteInstruction::WriteInstruction(size_t address, const std::string& value, const std::string& logPrefix)
+    : address(address), value(value), logPrefix(logPrefix) {
+}
+
+void WriteInstruction::execute(std::shared_ptr<Process> proc, int coreId) {
+    uint16_t stored = 0;
+    if (proc->memory.find(value) != proc->memory.end()) stored = proc->memory[value];
+    else {
+        try { stored = static_cast<uint16_t>(std::stoi(value)); }
+        catch (...) { stored = 0; }
+    }
+
+    MemoryManager::getInstance().write(*proc, coreId, address, stored);
+
+    std::ostringstream logEntry;
+    logEntry << "[" << getCurrentTimestamp() << "] "
+        << "Core " << coreId << " | PID " << proc->pid
+        << " | WRITE: " << stored << " to 0x" << std::hex << std::uppercase << address;
+    proc->logs.push_back(logEntry.str());
+    logToFile(proc->name, logEntry.str(), coreId);
+}
+
+void WriteInstruction::serialize(CheckpointWriter& out) const {
+    out.putU8(static_cast<uint8_t>(InstructionTag::WRITE));
+    out.putU32(static_cast<uint32_t>(address));
+    out.putString(value);
+    out.putString(logPrefix);
+}
+
+Opcode WriteInstruction::opcode() const {
+    return Opcode::WRITE;
+}
@@ -0,0 +1,23 @@
+#ifndef WRITEINSTRUCTION_H
+#define WRITEINSTRUCTION_H
+
+#include "Instruction.h"
+#include <string>
+#include <memory>
+#include <cstddef>
+
+// WRITE address, value: stores a variable or literal as 16 bits at address in the process's memory region
+class WriteInstruction : public Instruction {
+public:
+    size_t address;
+    std::string value;
+    std::string logPrefix = "";
+
+    WriteInstruction(size_t address, const std::string& value, const std::string& logPrefix = "");
+
+    void execute(std::shared_ptr<Process> proc, int coreId = -1) override;
+    void serialize(CheckpointWriter& out) const override;
+    Opcode opcode() const override;
+};
+
+#endif // WRITEINSTRUCTION_H
@@ -2,6 +2,9 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <exception>
 
 Config& Config::getInstance() {
     static Config instance;
@@ -16,23 +19,92 @@ bool Config::loadFromFile(const std::string& filename) {
     }
 
     std::string line;
+    int lineNumber = 0;
+    bool ok = true;
     while (std::getline(file, line)) {
+        lineNumber++;
         std::istringstream iss(line);
         std::string key, value;
         if (!(iss >> key >> value)) continue;
 
-        if (key == "num-cpu") numCPU = std::stoi(value);
-        else if (key == "scheduler") scheduler = value;
-        else if (key == "quantum-cycles") quantumCycles = std::stoi(value);
-        else if (key == "batch-process-freq") batchProcessFreq = std::stoi(value);
-        else if (key == "min-ins") minInstructions = std::stoi(value);
-        else if (key == "max-ins") maxInstructions = std::stoi(value);
-        else if (key == "delay-per-exec" || key == "delays-per-exec") delayPerInstruction = std::stoi(value);
-		else if (key == "max-overall-mem") maxOverallMem = std::stoul(value);
-		else if (key == "mem-per-proc") memPerProc = std::stoul(value);
-		else if (key == "mem-per-frame") memPerFrame = std::stoul(value);
-		
+        try {
+            if (key == "num-cpu") numCPU = std::stoi(value);
+            else if (key == "scheduler") scheduler = value;
+            else if (key == "quantum-cycles") quantumCycles = std::stoi(value);
+            else if (key == "batch-process-freq") batchProcessFreq = std::stoi(value);
+            else if (key == "min-ins") minInstructions = std::stoi(value);
+            else if (key == "max-ins") maxInstructions = std::stoi(value);
+            else if (key == "delay-per-exec" || key == "delays-per-exec") delayPerInstruction = std::stoi(value);
+            else if (key == "max-overall-mem") maxOverallMem = std::stoul(value);
+            else if (key == "mem-per-proc") memPerProc = std::stoul(value);
+            else if (key == "mem-per-frame") memPerFrame = std::stoul(value);
+            else if (key == "memory-op-percent") memoryOpPercent = std::stoi(value);
+            else if (key == "tlb-miss-penalty") tlbMissPenalty = std::stoi(value);
+            else if (key == "page-replacement") pageReplacement = value;
+            else if (key == "page-fault-penalty") pageFaultPenalty = std::stoi(value);
+            else if (key == "memory-arenas") memoryArenas = std::stoi(value);
+            else if (key == "metrics-socket") metricsSocket = value;
+            else if (key == "timeline-file") timelineFile = value;
+            else if (key == "core-affinity-window") coreAffinityWindow = std::stoi(value);
+            else if (key == "dispatcher") dispatcher = value;
+            else if (key == "affinity") affinity = value;
+            else if (key == "affinity-cpus") affinityCpus = value;
+            else if (key == "affinity-tick-cpu") affinityTickCpu = std::stoi(value);
+            else if (key == "log-buffer-lines") logBufferLines = std::stoul(value);
+            else if (key == "resident-finished") residentFinished = std::stoul(value);
+            else if (key == "archive-file") archiveFile = value;
+            else if (key == "seed") seed = static_cast<unsigned int>(std::stoul(value));
+            else if (key == "arrival-mode") arrivalMode = value;
+            else if (key == "arrival-rate") arrivalRate = std::stod(value);
+            else if (key == "burst-on") burstOn = std::stoi(value);
+            else if (key == "burst-off") burstOff = std::stoi(value);
+            else if (key == "arrival-trace") arrivalTrace = value;
+            else if (key == "batch-size") batchSize = std::stoi(value);
+            else if (key == "ins-dist") insDist = value;
+            else if (key == "mem-dist") memDist = value;
+            else if (key == "min-mem-per-proc") minMemPerProc = std::stoul(value);
+            else if (key == "max-mem-per-proc") maxMemPerProc = std::stoul(value);
+            else if (key == "max-in-flight") maxInFlight = std::stoi(value);
+            else if (key == "queue-high-watermark") queueHighWatermark = std::stoi(value);
+            else if (key == "queue-low-watermark") queueLowWatermark = std::stoi(value);
+            else if (key == "free-mem-low-watermark") freeMemLowWatermark = std::stoul(value);
+            else if (key == "free-mem-high-watermark") freeMemHighWatermark = std::stoul(value);
+            else if (key == "admission-policy") admissionPolicy = value;
+        }
+        catch (const std::exception&) {
+            // Keeps the value already set, so one typo does not take down a running emulator
+            std::cerr << "Error: invalid value '" << value << "' for " << key << " in " << filename
+                << " (line " << lineNumber << ")\n";
+            ok = false;
+        }
     }
 
-    return true;
+    return ok;
+}
+
+void Config::copySchedulerSettings(const Config& from) {
+    numCPU = from.numCPU;
+    scheduler = from.scheduler;
+    quantumCycles = from.quantumCycles;
+    delayPerInstruction = from.delayPerInstruction;
+    tlbMissPenalty = from.tlbMissPenalty;
+    pageFaultPenalty = from.pageFaultPenalty;
+    coreAffinityWindow = from.coreAffinityWindow;
+    affinity = from.affinity;
+    affinityCpus = from.affinityCpus;
+    affinityTickCpu = from.affinityTickCpu;
+    dispatcher = from.dispatcher;
+}
+
+bool Config::validateLive(std::string& error) const {
+    std::string policy = scheduler;
+    std::transform(policy.begin(), policy.end(), policy.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (policy != "fcfs" && policy != "rr" && policy != "round_robin") error = "scheduler must be fcfs or rr";
+    else if (numCPU < 1 || numCPU > MAX_CORES) error = "num-cpu must be between 1 and " + std::to_string(MAX_CORES);
+    else if (quantumCycles < 1) error = "quantum-cycles must be at least 1";
+    else if (delayPerInstruction < 0) error = "delay-per-exec must not be negative";
+    else if (tlbMissPenalty < 0 || pageFaultPenalty < 0) error = "penalties must not be negative";
+    else if (coreAffinityWindow < 0) error = "core-affinity-window must not be negative";
+    else return true;
+    return false;
 }
@@ -3,12 +3,15 @@
 
 #include <string>
 
-class Config {
-private:
-    Config() = default;
+// Upper bound for num-cpu. Core slots are allocated up front so reload-config can grow
+// the pool without moving per-core state.
+constexpr int MAX_CORES = 128;
 
+class Config {
 public:
     static Config& getInstance();
+    // Standalone copies are for staging a file (reload-config) before anything reads it
+    Config() = default;
 
     Config(const Config&) = delete;
     Config& operator=(const Config&) = delete;
@@ -20,14 +23,77 @@ public:
     int minInstructions = 1000;
     int maxInstructions = 2000;
     int delayPerInstruction = 100;
+    unsigned int seed = 0;           // 0 = nondeterministic process generation
+
+    // Workload shape (arrivals are counted in scheduler ticks)
+    std::string arrivalMode = "fixed";  // fixed | poisson | bursty | trace
+    double arrivalRate = 0.0;        // poisson: mean arrivals per tick, 0 = 1 / batch-process-freq
+    int burstOn = 10;                // bursty: ticks generating...
+    int burstOff = 10;               // ...then ticks idle
+    std::string arrivalTrace;        // trace: file of "<tick> [count]" lines
+    int batchSize = 1;               // processes created per arrival
+    std::string insDist = "uniform"; // instruction count: uniform | exponential | normal
+    std::string memDist = "fixed";   // memory size: fixed | uniform | pow2
+    size_t minMemPerProc = 0;        // uniform/pow2 memory range, 0 = mem-per-proc
+    size_t maxMemPerProc = 0;
+
+    // Admission control (0 = limit disabled)
+    int maxInFlight = 0;             // arrived but unfinished processes
+    int queueHighWatermark = 0;      // pause generation at this ready-queue depth...
+    int queueLowWatermark = 0;       // ...until it drains to this (0 = half the high mark)
+    size_t freeMemLowWatermark = 0;  // pause when free memory drops below this many bytes...
+    size_t freeMemHighWatermark = 0; // ...until it recovers to this (0 = the low mark)
+    std::string admissionPolicy = "defer";  // defer: hold arrivals until admitted, reject: drop them
 
     // Memory management parameters
     size_t maxOverallMem = 16384;    // Total memory in bytes
     size_t memPerProc = 4096;        // Memory per process in bytes
     size_t memPerFrame = 16;         // Memory per frame in bytes
+    int memoryOpPercent = 0;         // share of generated instructions that are READ/WRITE
+    int tlbMissPenalty = 0;          // ms a core stalls per TLB miss, on top of delay-per-exec
+    // none = contiguous first-fit blocks; fifo | lru | clock | second-chance = demand
+    // paging with mem-per-frame pages and that replacement policy
+    std::string pageReplacement = "none";
+    int pageFaultPenalty = 0;        // ms a core stalls per page fault
+    // Contiguous memory is split into this many arenas, each with its own lock; 0 = one
+    // per core, limited so every arena still holds a largest-size process
+    int memoryArenas = 0;
+
+    // Chrome trace-event JSON of per-core activity, written when the scheduler stops; empty = off
+    std::string timelineFile;
+
+    // Per-process log lines kept in memory; older lines spill to <process>_log.<n>.spill
+    size_t logBufferLines = 100;
+
+    // Finished processes beyond the newest resident-finished are evicted to a summary
+    // record, with their logs compressed into archive-file
+    size_t residentFinished = 100;
+    std::string archiveFile = "csopesy-archive.bin";
+
+    // Soft process-to-core affinity: a preempted process waits up to this many ticks
+    // for its previous core before another core may take it (0 = plain FIFO)
+    int coreAffinityWindow = 0;
+
+    // shared: every core takes work from the ready queue itself. central: one dispatcher
+    // thread owns the ready queue and hands processes to cores through per-core mailboxes
+    std::string dispatcher = "shared";
+
+    // Host CPU placement: none (OS decides), auto (physical cores first, then SMT
+    // siblings) or manual (affinity-cpus lists the host CPU for core 0, 1, ...)
+    std::string affinity = "none";
+    std::string affinityCpus;        // comma separated, reused round-robin past the end
+    int affinityTickCpu = -1;        // tick thread; -1 = last CPU of the placement order
+
+    // Observability
+    std::string metricsSocket;       // UNIX socket path for the metrics exporter, empty = disabled
 
-    // Method to load configuration from file
+    // Method to load configuration from file; false if it cannot be opened or a value does not parse
     bool loadFromFile(const std::string& filename);
+    // Range checks for the values reload-config applies to a running scheduler
+    bool validateLive(std::string& error) const;
+    // Copies the settings reload-config applies to a running scheduler (num-cpu, policy,
+    // quantum, delay, penalties, core affinity, host affinity, dispatcher)
+    void copySchedulerSettings(const Config& from);
 };
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -1,14 +1,68 @@
 #include "CLIManager.h"
 #include "config.h"
 #include "MemoryManager.h"
+#include "MetricsExporter.h"
+#include "Benchmark.h"
+#include "scheduler.h"
 #include <iostream>
+#include <string>
+#include <cstdlib>
 
-int main() {
+int main(int argc, char* argv[]) {
     Config& config = Config::getInstance();
 
     // Load configuration (assuming config.loadFromFile is implemented)
     if (!config.loadFromFile("config.txt")) {
-        std::cout << "Warning: Could not load config.txt, using default values.\n";
+        std::cout << "Warning: Could not load config.txt fully; settings it does not give keep their default values.\n";
+    }
+
+    // Headless modes: --bench micro | --bench scaling [options], or
+    // --script <file> / --run-for <ticks> [--summary <file>]; --restore <checkpoint> works with either
+    std::string scriptPath;
+    std::string restorePath;
+    std::string summaryPath = "csopesy-summary.json";
+    int runForTicks = 0;
+    bool batch = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value = (i + 1 < argc) ? argv[i + 1] : "";
+        if (arg == "--bench") {
+            std::string mode = value.empty() ? "micro" : value;
+            if (mode == "micro") return runMicroBenchmarks();
+            if (mode == "scaling") return runScalingBenchmark(argc, argv);
+            std::cout << "Unknown benchmark mode: " << mode << "\n";
+            return 1;
+        }
+        if (arg == "--restore") {
+            if (value.empty()) {
+                std::cout << "Missing value for " << arg << "\n";
+                return 1;
+            }
+            restorePath = value;
+            ++i;
+            continue;
+        }
+        if (arg == "--script" || arg == "--run-for" || arg == "--summary") {
+            if (value.empty()) {
+                std::cout << "Missing value for " << arg << "\n";
+                return 1;
+            }
+            if (arg == "--script") scriptPath = value;
+            else if (arg == "--summary") summaryPath = value;
+            else runForTicks = std::atoi(value.c_str());
+            batch = true;
+            ++i;
+        }
+    }
+
+    if (batch) {
+        if (!config.metricsSocket.empty()) MetricsExporter::getInstance().start(config.metricsSocket);
+        CLIManager cli;
+        if (!restorePath.empty()) {
+            setSchedulerQuiet(true);
+            if (!cli.restore(restorePath)) return 1;
+        }
+        return cli.runScript(scriptPath, runForTicks, summaryPath);
     }
 
     // Display configuration
@@ -25,7 +79,17 @@ int main() {
     std::cout << "Memory per Frame: " << config.memPerFrame << " bytes\n";
     std::cout << "==============================\n\n";
 
+    if (!config.metricsSocket.empty()) {
+        if (MetricsExporter::getInstance().start(config.metricsSocket)) {
+            std::cout << "Metrics available on UNIX socket " << config.metricsSocket << "\n\n";
+        }
+        else {
+            std::cout << "Warning: Could not open metrics socket " << config.metricsSocket << "\n\n";
+        }
+    }
+
     CLIManager cli;
+    if (!restorePath.empty() && !cli.restore(restorePath)) return 1;
     cli.run();
 
     return 0;
@@ -10,6 +10,9 @@
 #include <fstream>
 #include <ctime>
 #include <unordered_map>
+#include "utils.h"
+#include "ProcessLog.h"
+#include "Profiler.h"
 
 class Instruction;
 
@@ -22,29 +25,46 @@ enum class ProcessStatus {
 struct Process {
     int pid = -1;  //  Initialized
     std::string name;
+    unsigned int seed = 0;  // Seed the instruction stream was generated from
     int instructionPointer = 0;  //  Initialized
     std::vector<std::shared_ptr<Instruction>> instructions;
     std::unordered_map<std::string, uint16_t> memory;
 
     int baseAddress = -1;
     size_t requiredMemory;
-    ProcessStatus status = ProcessStatus::READY;
+    std::atomic<ProcessStatus> status{ ProcessStatus::READY };
 
+    // Written by the cores, read by reports and the CLI without taking any scheduler lock
     std::atomic<int> coreAssigned{ -1 };
-    bool isRunning = false;
-    bool isFinished = false;
+    std::atomic<bool> isRunning{ false };
+    std::atomic<bool> isFinished{ false };
     bool isDetached = false;
 
     std::string arrivalTime;
     std::string startTime;
     std::string endTime;
+
+    // Scheduler tick timestamps for latency accounting (-1 = not reached yet)
+    int arrivalTick = -1;
+    int firstDispatchTick = -1;
+    int completionTick = -1;
+    int readySinceTick = -1;
+    int waitingTicks = 0;
+    int preemptions = 0;
+    int migrations = 0;  // dispatches onto a different core than the previous one
+    std::string terminationReason;  // set when the process was killed instead of completing
+
+    // Demand paging; evictions and write-backs may be caused by other processes' faults
+    std::atomic<int> pageFaults{ 0 };
+    std::atomic<int> pageEvictions{ 0 };
+    std::atomic<int> pageWritebacks{ 0 };
     std::atomic<int> wakeupTick{ 0 };
 
     int totalInstructions = 0;
     std::shared_ptr<std::atomic<int>> completedInstructions;
+    OpcodeProfile profile;  // written by the core running the process
 
-    std::vector<std::string> logs;
-    mutable std::mutex logMutex;
+    ProcessLog logs{ name };
 
     Process() : completedInstructions(std::make_shared<std::atomic<int>>(0)) {}
 
@@ -66,11 +86,8 @@ struct Process {
     int getWakeupTick() const { return wakeupTick.load(); }
 
     void log(const std::string& message) {
-        std::lock_guard<std::mutex> lock(logMutex);
         auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::tm tm;
-        localtime_s(&tm, &time_t);
+        std::tm tm = toLocalTime(std::chrono::system_clock::to_time_t(now));
 
         char timeBuffer[100];
         strftime(timeBuffer, sizeof(timeBuffer), "[%m/%d/%Y %I:%M:%S%p]", &tm);
@@ -79,7 +96,6 @@ struct Process {
     }
 
     void writeLogToFile() const {
-        std::lock_guard<std::mutex> lock(logMutex);
         std::string filename = name + "_log.txt";
         std::ofstream file(filename);
 
@@ -88,10 +104,7 @@ struct Process {
         file << "Process Log for " << name << " (PID: " << pid << ")\n";
         file << "===========================================\n\n";
 
-        for (const auto& logEntry : logs) {
-            file << logEntry << "\n";
-        }
-
+        logs.writeAll(file);
         file.close();
     }
 
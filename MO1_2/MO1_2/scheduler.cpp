@@ -3,7 +3,14 @@
 #include "ProcessManager.h"
 #include "config.h"
 #include "utils.h"
-#include "instruction.h"
+#include "Instruction.h"
+#include "TraceRecorder.h"
+#include "LatencyStats.h"
+#include "Profiler.h"
+#include "Timeline.h"
+#include "ProgramCache.h"
+#include "SleepInstruction.h"
+#include "Checkpoint.h"
 
 #include <iostream>
 #include <fstream>
@@ -11,18 +18,25 @@
 #include <algorithm>
 #include <chrono>
 #include <thread>
+#include <unordered_map>
 
 // Global variables
 std::vector<std::shared_ptr<Process>> allProcesses;
 bool stop = false;
 bool running = false;
 SchedulerType schedulerType = SchedulerType::ROUND_ROBIN;
-int cpuTick = 0;
+std::atomic<int> cpuTick{ 0 };
 int timeQuantum = 3;
 
 // Global scheduler instance
 static ProcessScheduler globalScheduler;
 
+static bool wantsCentralDispatch(const Config& config) {
+    std::string mode = config.dispatcher;
+    std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+    return mode == "central";
+}
+
 ProcessScheduler::~ProcessScheduler() {
     stop();
 }
@@ -33,9 +47,15 @@ void ProcessScheduler::start(const Config& config) {
         return;
     }
 
-    numCPU = config.numCPU;
+    numCPU = std::min(std::max(config.numCPU, 1), MAX_CORES);
+    if (numCPU != config.numCPU) {
+        std::cout << "num-cpu " << config.numCPU << " is outside 1-" << MAX_CORES << "; using " << numCPU << " cores.\n";
+    }
     timeQuantum = config.quantumCycles;
     delayPerInstruction = config.delayPerInstruction;
+    tlbMissPenalty = std::max(config.tlbMissPenalty, 0);
+    pageFaultPenalty = std::max(config.pageFaultPenalty, 0);
+    affinityWindow = std::max(config.coreAffinityWindow, 0);
 
     std::string sched = config.scheduler;
     std::transform(sched.begin(), sched.end(), sched.begin(), ::toupper);
@@ -44,21 +64,41 @@ void ProcessScheduler::start(const Config& config) {
         ? SchedulerType::ROUND_ROBIN
         : SchedulerType::FCFS;
 
-    coreAvailable.assign(numCPU, true);
+    coreCapacity = MAX_CORES;
+    coreStates.reset(new CoreState[coreCapacity]);
+    // Trace replay decides placement itself, so it always uses the shared queue
+    centralDispatch = wantsCentralDispatch(config) && (!replayer || replayer->finished());
+    channels.reset(centralDispatch ? new CoreChannel[coreCapacity] : nullptr);
+    inFlight = 0;
+    dispatchHeld = false;
+    dispatcherParked = false;
     shouldStop = false;
     gracefulStop = false;
     running = true;
-    quantumCycle = 0;
+    quantumCycle = startTick;
+    cpuTick = startTick;
+    // Tick-based samples from an earlier run would mix with this clock; a restore continues its run
+    if (startTick == 0) LatencyStats::getInstance().reset();
+    pauseRequested = false;
+    parkedCores = 0;
+    parkedProcesses.assign(coreCapacity, nullptr);
+    startedAt = std::chrono::steady_clock::now();
+    instructionsPerSecond = 0;
+    Timeline::getInstance().begin(config.timelineFile);
 
     workerThreads.clear();
+    workerThreads.resize(coreCapacity);
     for (int i = 0; i < numCPU; ++i) {
-        workerThreads.emplace_back(&ProcessScheduler::cpuWorker, this, i);
+        workerThreads[i] = std::thread(&ProcessScheduler::cpuWorker, this, i);
     }
-    workerThreads.emplace_back(&ProcessScheduler::schedulerLoop, this);
+    tickThread = std::thread(&ProcessScheduler::schedulerLoop, this);
+    if (centralDispatch) dispatcherThread = std::thread(&ProcessScheduler::dispatcherLoop, this);
+    applyAffinity(config);
 
+    if (quiet) return;
     std::cout << "ProcessScheduler started with " << numCPU << " cores using "
         << (schedulerType == SchedulerType::FCFS ? "FCFS" : "Round Robin")
-        << " scheduling.\n";
+        << " scheduling" << (centralDispatch ? " (central dispatcher)" : "") << ".\n";
 }
 
 //void ProcessScheduler::stop() {
@@ -99,16 +139,21 @@ void ProcessScheduler::stop() {
     if (!running.load()) return;
 
     gracefulStop = true;
-    std::cout << "[INFO] Stopping process generation, waiting for queue to empty...\n";
+    if (!quiet) std::cout << "[INFO] Stopping process generation, waiting for queue to empty...\n";
+
+    // An unfinished replay falls back to live scheduling so the queue can drain
+    if (replayer) replayer->abort();
 
     // Detach a background thread to handle graceful shutdown
     std::thread([this]() {
         while (true) {
             {
                 std::lock_guard<std::mutex> lock(queueMutex);
-                bool allCoresFree = std::all_of(coreAvailable.begin(), coreAvailable.end(),
-                    [](bool v) { return v; });
-                if (readyQueue.empty() && allCoresFree) break;
+                bool allCoresFree = true;
+                for (int i = 0; i < numCPU; ++i) {
+                    if (!coreStates[i].isIdle()) allCoresFree = false;
+                }
+                if (readyQueue.empty() && allCoresFree && inFlight.load() == 0) break;
             }
             std::this_thread::sleep_for(std::chrono::milliseconds(200));
         }
@@ -119,140 +164,669 @@ void ProcessScheduler::stop() {
             if (thread.joinable()) thread.join();
         }
         workerThreads.clear();
-        coreAvailable.clear();
+        if (dispatcherThread.joinable()) dispatcherThread.join();
+        if (tickThread.joinable()) tickThread.join();
+        Timeline::getInstance().finish();
         running = false;
 
-        std::cout << "\nProcessScheduler stopped gracefully.\n> ";
+        std::cout << "\nProcessScheduler stopped gracefully.\n";
+        if (!quiet) std::cout << "> ";
         std::cout.flush();
         }).detach();
 }
 
+void ProcessScheduler::shutdown() {
+    if (!running.load()) return;
+
+    if (replayer) replayer->abort();
+    shouldStop = true;
+    queueCV.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(pauseMutex);
+        pauseCV.notify_all();
+    }
+
+    // A graceful stop already owns the workers; let its thread finish joining them
+    if (gracefulStop) {
+        while (running.load()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return;
+    }
+
+    for (auto& thread : workerThreads) {
+        if (thread.joinable()) thread.join();
+    }
+    workerThreads.clear();
+    if (dispatcherThread.joinable()) dispatcherThread.join();
+    if (tickThread.joinable()) tickThread.join();
+    Timeline::getInstance().finish();
+    running = false;
+}
+
+// Pins the active workers and the tick thread according to the affinity keys
+void ProcessScheduler::applyAffinity(const Config& config) {
+    if (!planAffinity(config, affinity)) {
+        std::cout << "CPU affinity disabled; threads are left to the OS.\n";
+    }
+    if (!affinity.enabled) return;
+
+    int cores = numCPU.load();
+    for (int i = 0; i < cores; ++i) pinThread(workerThreads[i], affinity.cpuForCore(i));
+    pinThread(tickThread, affinity.tickCpu);
+    if (dispatcherThread.joinable()) pinThread(dispatcherThread, affinity.tickCpu);
+    if (!quiet) affinity.describe(std::cout, cores);
+}
+
+bool ProcessScheduler::reconfigure(const Config& config) {
+    if (!running.load() || gracefulStop) {
+        std::cout << "Scheduler is stopping; reload the configuration again once it has stopped.\n";
+        return false;
+    }
+    if (replayer && !replayer->finished()) {
+        std::cout << "Cannot reconfigure while a trace replay is running.\n";
+        return false;
+    }
+
+    std::string sched = config.scheduler;
+    std::transform(sched.begin(), sched.end(), sched.begin(), ::toupper);
+    schedulerType = (sched == "RR" || sched == "ROUND_ROBIN") ? SchedulerType::ROUND_ROBIN : SchedulerType::FCFS;
+    timeQuantum = std::max(config.quantumCycles, 1);
+    delayPerInstruction = std::max(config.delayPerInstruction, 0);
+    tlbMissPenalty = std::max(config.tlbMissPenalty, 0);
+    pageFaultPenalty = std::max(config.pageFaultPenalty, 0);
+    affinityWindow = std::max(config.coreAffinityWindow, 0);
+    queueCV.notify_all();
+
+    int current = numCPU.load();
+    int target = std::min(std::max(config.numCPU, 1), coreCapacity);
+    if (target > current) {
+        numCPU = target;
+        // The dispatcher may still be releasing these slots from an older, smaller pool
+        if (centralDispatch) waitForDispatcherPass();
+        for (int i = current; i < target; ++i) {
+            publishCore(i, -1, -1);
+            if (centralDispatch) channels[i].released = false;
+            workerThreads[i] = std::thread(&ProcessScheduler::cpuWorker, this, i);
+        }
+    }
+    else if (target < current) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            numCPU = target;
+        }
+        queueCV.notify_all();
+        // Removed cores finish their current instruction, requeue the process and exit
+        for (int i = target; i < current; ++i) {
+            if (workerThreads[i].joinable()) workerThreads[i].join();
+        }
+    }
+    applyAffinity(config);
+    if (wantsCentralDispatch(config) != centralDispatch) {
+        std::cout << "The dispatcher setting applies at the next scheduler-start.\n";
+    }
+
+    std::cout << "Scheduler reconfigured: " << target << " cores";
+    if (target != current) std::cout << " (was " << current << ")";
+    std::cout << ", " << (schedulerType == SchedulerType::FCFS ? "FCFS" : "Round Robin")
+        << ", quantum " << timeQuantum << ", delay " << delayPerInstruction << "ms.\n";
+    return true;
+}
+
 
 void ProcessScheduler::addProcess(std::shared_ptr<Process> process) {
     if (!process) return;
 
     process->setStatus(ProcessStatus::READY);
     process->arrivalTime = getCurrentTimestamp();
+    process->arrivalTick = cpuTick.load();
+    processesArrived.fetch_add(1, std::memory_order_relaxed);
+    process->readySinceTick = process->arrivalTick;
 
     {
         std::lock_guard<std::mutex> lock(queueMutex);
-        readyQueue.push(process);
+        readyQueue.push_back(process);
+        readyDepth = static_cast<int>(readyQueue.size());
+        TraceRecorder::getInstance().record(TraceEventType::ARRIVAL, -1, process->pid, process->seed, process->name,
+            static_cast<uint32_t>(process->totalInstructions), static_cast<uint32_t>(process->getRequiredMemory()));
     }
 
     queueCV.notify_one();
 }
 
 void ProcessScheduler::schedulerLoop() {
+    auto rateStart = std::chrono::steady_clock::now();
+    uint64_t rateBase = totalInstructions();
+
     while (!shouldStop.load()) {
-        quantumCycle.fetch_add(1);
+        int tick = quantumCycle.fetch_add(1) + 1;
+        cpuTick = tick;
+
+        for (int i = 0; i < numCPU; ++i) {
+            CoreState& core = coreStates[i];
+            if (core.isIdle()) core.idleTicks.fetch_add(1, std::memory_order_relaxed);
+            else core.busyTicks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Refresh the instructions/sec gauge roughly once per second
+        if (tick % 10 == 0) {
+            auto now = std::chrono::steady_clock::now();
+            uint64_t total = totalInstructions();
+            double seconds = std::chrono::duration<double>(now - rateStart).count();
+            if (seconds > 0) instructionsPerSecond = static_cast<uint64_t>((total - rateBase) / seconds);
+            rateStart = now;
+            rateBase = total;
+        }
+
+        Timeline& timeline = Timeline::getInstance();
+        if (timeline.isActive()) timeline.record(-1, TimelineKind::QUEUE_DEPTH, -1, timeline.now(), readyDepth.load());
+
         MemoryManager::getInstance().incrementCycle();
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 }
 
 void ProcessScheduler::cpuWorker(int coreId) {
-    while (true) {
+    // Under central dispatch a removed core keeps polling until the dispatcher releases it
+    while (centralDispatch || !isRetired(coreId)) {
         std::shared_ptr<Process> process;
 
-        {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            queueCV.wait(lock, [this] {
-                return !readyQueue.empty() || shouldStop.load();
-                });
-
-            if (shouldStop.load() && readyQueue.empty()) break;
+        if (replayer && !replayer->finished()) {
+            process = takeReplayDispatch(coreId);
+        }
 
-            if (!readyQueue.empty()) {
-                process = readyQueue.front();
-                readyQueue.pop();
-            }
-            else {
-                continue;
+        if (!process) {
+            process = centralDispatch ? receive(coreId) : takeNext(coreId);
+            if (!process) {
+                if (pauseRequested.load() && !shouldStop.load() && !isRetired(coreId)) {
+                    parkCore(coreId, nullptr);
+                    continue;
+                }
+                break;
             }
         }
 
-        if (!process) continue;
-
         // Try memory allocation
-        if (!tryAllocateMemory(process)) {
+        if (!tryAllocateMemory(process, coreId)) {
+            Timeline& timeline = Timeline::getInstance();
+            int64_t failedAt = timeline.now();
+            int requested = static_cast<int>(process->getRequiredMemory());
+            if (centralDispatch) {
+                TraceRecorder::getInstance().record(TraceEventType::REQUEUE, coreId, process->pid, process->instructionPointer);
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                timeline.record(coreId, TimelineKind::ALLOC_FAIL, process->pid, failedAt, requested);
+                complete(coreId, process);
+                continue;
+            }
+            bool replayTurn = replayer && replayer->awaitTurn(TraceEventType::REQUEUE, coreId, process->pid);
             {
                 std::lock_guard<std::mutex> lock(queueMutex);
-                readyQueue.push(process);
+                readyQueue.push_back(process);
+                readyDepth = static_cast<int>(readyQueue.size());
+                TraceRecorder::getInstance().record(TraceEventType::REQUEUE, coreId, process->pid, process->instructionPointer);
             }
+            if (replayTurn) replayer->advance();
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            timeline.record(coreId, TimelineKind::ALLOC_FAIL, process->pid, failedAt, requested);
             queueCV.notify_one();
             continue;
         }
 
-        coreAvailable[coreId] = false;
-        process->coreAssigned = coreId;
+        int now = cpuTick.load();
+        process->waitingTicks += now - process->readySinceTick;
+        if (process->firstDispatchTick < 0) process->firstDispatchTick = now;
+        if (process->startTime.empty()) process->startTime = getCurrentTimestamp();
+
+        int lastCore = process->coreAssigned.exchange(coreId);
+        if (lastCore >= 0 && lastCore != coreId) {
+            process->migrations++;
+            coreStates[coreId].migrations.fetch_add(1, std::memory_order_relaxed);
+        }
         process->isRunning = true;
         process->setStatus(ProcessStatus::RUNNING);
+        MemoryManager::getInstance().switchContext(coreId, process->pid);
+        publishCore(coreId, process->pid, now);
+        coreStates[coreId].dispatches.fetch_add(1, std::memory_order_relaxed);
 
         executeProcess(process, coreId);
+        publishCore(coreId, -1, -1);
+        if (centralDispatch) complete(coreId, process);
+    }
+}
+
+// Central dispatch: the only thread that takes processes off the ready queue. Each pass
+// collects what the cores handed back, releases removed cores, then gives every idle
+// active core the process pickFor() chooses for it. Cores never lock queueMutex.
+void ProcessScheduler::dispatcherLoop() {
+    std::vector<char> busy(coreCapacity, 0);  // a process is outstanding on this core
+    int idle = 0;
+    while (!shouldStop.load()) {
+        dispatcherPasses.fetch_add(1);
+        bool progress = drainCompletions(busy);
+        if (pauseRequested.load()) {
+            holdDispatch(busy);
+            continue;
+        }
+
+        int cores = numCPU.load();
+        for (int i = cores; i < coreCapacity; ++i) {
+            if (!busy[i] && !channels[i].released.load(std::memory_order_relaxed)) {
+                channels[i].released.store(true, std::memory_order_release);
+            }
+        }
 
-        coreAvailable[coreId] = true;
-        process->isRunning = false;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            for (int i = 0; i < cores && !readyQueue.empty(); ++i) {
+                if (busy[i]) continue;
+                auto pick = pickFor(i);
+                if (pick == readyQueue.end()) continue;
+                auto process = *pick;
+                readyQueue.erase(pick);
+                TraceRecorder::getInstance().record(TraceEventType::DISPATCH, i, process->pid, process->instructionPointer);
+                busy[i] = 1;
+                inFlight.fetch_add(1);
+                channels[i].mailbox.push(process);  // never full: one process outstanding per core
+                progress = true;
+            }
+            readyDepth = static_cast<int>(readyQueue.size());
+        }
+
+        if (progress) idle = 0;
+        else if (++idle < IDLE_SPINS) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 }
 
-bool ProcessScheduler::tryAllocateMemory(std::shared_ptr<Process> process) {
+// Takes back every process the cores have finished with; returns true if there were any
+bool ProcessScheduler::drainCompletions(std::vector<char>& busy) {
+    bool drained = false;
+    CoreCompletion done;
+    for (int i = 0; i < coreCapacity; ++i) {
+        if (!busy[i]) continue;
+        while (channels[i].completions.pop(done)) {
+            busy[i] = 0;
+            if (done.requeue) {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                readyQueue.push_back(done.process);
+                readyDepth = static_cast<int>(readyQueue.size());
+            }
+            inFlight.fetch_sub(1);
+            done.process.reset();
+            drained = true;
+        }
+    }
+    return drained;
+}
+
+// Checkpoint quiescence for the dispatcher: stop placing work, keep collecting
+// completions until every core has parked, then park so the ready queue is final
+void ProcessScheduler::holdDispatch(std::vector<char>& busy) {
+    dispatchHeld = true;
+    while (!shouldStop.load()) {
+        drainCompletions(busy);
+        std::unique_lock<std::mutex> lock(pauseMutex);
+        if (!pauseRequested.load()) break;
+        if (parkedCores == numCPU) {
+            drainCompletions(busy);
+            dispatcherParked = true;
+            pauseCV.notify_all();
+            pauseCV.wait(lock, [this] { return !pauseRequested.load() || shouldStop.load(); });
+            dispatcherParked = false;
+            pauseCV.notify_all();
+            break;
+        }
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    dispatchHeld = false;
+}
+
+// Returns once the dispatcher has begun a full pass after the caller's last store
+void ProcessScheduler::waitForDispatcherPass() {
+    uint64_t target = dispatcherPasses.load() + 2;
+    while (dispatcherPasses.load() < target && !shouldStop.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Central dispatch: polls this core's mailbox. Returns null when the core should park
+// for a checkpoint, has been released after removal, or the scheduler is stopping.
+std::shared_ptr<Process> ProcessScheduler::receive(int coreId) {
+    CoreChannel& channel = channels[coreId];
+    for (int idle = 0;; ++idle) {
+        // Read before the mailbox: both are only set after the dispatcher's last push to
+        // this core, so an empty mailbox seen afterwards stays empty
+        bool released = channel.released.load(std::memory_order_acquire);
+        bool held = pauseRequested.load() && dispatchHeld.load();
+
+        std::shared_ptr<Process> process;
+        if (channel.mailbox.pop(process)) return process;
+        if (released || held || shouldStop.load()) return nullptr;
+
+        if (idle < IDLE_SPINS) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Hands a dispatched process back; it goes to the tail of the ready queue if it is still READY
+void ProcessScheduler::complete(int coreId, std::shared_ptr<Process> process) {
+    CoreCompletion done{ process, process->getStatus() == ProcessStatus::READY };
+    while (!channels[coreId].completions.push(done)) std::this_thread::yield();
+}
+
+std::shared_ptr<Process> ProcessScheduler::takeNext(int coreId) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    std::deque<std::shared_ptr<Process>>::iterator pick;
+    while (true) {
+        queueCV.wait(lock, [this, coreId] {
+            return !readyQueue.empty() || shouldStop.load() || pauseRequested.load() || isRetired(coreId);
+            });
+
+        // A graceful stop only sets shouldStop once the queue is empty; shutdown() abandons whatever is left
+        if (readyQueue.empty() || shouldStop.load() || pauseRequested.load() || isRetired(coreId)) return nullptr;
+
+        pick = pickFor(coreId);
+        if (pick != readyQueue.end()) break;
+        // Everything near the head is held for other cores; re-check once a tick has passed
+        queueCV.wait_for(lock, std::chrono::milliseconds(100));
+    }
+
+    auto process = *pick;
+    readyQueue.erase(pick);
+    readyDepth = static_cast<int>(readyQueue.size());
+    TraceRecorder::getInstance().record(TraceEventType::DISPATCH, coreId, process->pid, process->instructionPointer);
+    return process;
+}
+
+// Soft core affinity, called with queueMutex held. A process that ran recently stays
+// reserved for its last core for core-affinity-window ticks after it became ready,
+// so other cores skip it and take the next process in FIFO order instead. Only the
+// first AFFINITY_SCAN entries are considered to bound the time spent under the lock.
+std::deque<std::shared_ptr<Process>>::iterator ProcessScheduler::pickFor(int coreId) {
+    int window = affinityWindow.load(std::memory_order_relaxed);
+    if (window <= 0) return readyQueue.begin();
+
+    int now = cpuTick.load();
+    size_t scanned = 0;
+    for (auto it = readyQueue.begin(); it != readyQueue.end() && scanned < AFFINITY_SCAN; ++it, ++scanned) {
+        int last = (*it)->coreAssigned.load();
+        bool reserved = last >= 0 && last != coreId && !isRetired(last) &&
+            now - (*it)->readySinceTick < window;
+        if (!reserved) return it;
+    }
+    return readyQueue.end();
+}
+
+bool ProcessScheduler::tryAllocateMemory(std::shared_ptr<Process> process, int coreId) {
     if (process->getBaseAddress() != -1) return true;
-    return MemoryManager::getInstance().allocate(process);
+
+    bool replayTurn = replayer && replayer->awaitTurn(TraceEventType::ALLOC, coreId, process->pid);
+    bool allocated = MemoryManager::getInstance().allocate(process, coreId);
+    if (replayTurn) {
+        replayer->checkAllocation(process->pid, allocated);
+        replayer->advance();
+    }
+    return allocated;
 }
 
-void ProcessScheduler::executeProcess(std::shared_ptr<Process> process, int coreId) {
-    if (process->startTime.empty()) {
-        process->startTime = getCurrentTimestamp();
+// Pops the process the trace dispatched next on this core. Returns null once the
+// replay is over (or diverged) so the worker falls back to the live ready queue.
+std::shared_ptr<Process> ProcessScheduler::takeReplayDispatch(int coreId) {
+    int pid = replayer->awaitDispatch(coreId);
+    if (pid < 0) return nullptr;
+
+    std::shared_ptr<Process> process;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto it = std::find_if(readyQueue.begin(), readyQueue.end(),
+            [pid](const std::shared_ptr<Process>& p) { return p->pid == pid; });
+        if (it != readyQueue.end()) {
+            process = *it;
+            readyQueue.erase(it);
+            readyDepth = static_cast<int>(readyQueue.size());
+            TraceRecorder::getInstance().record(TraceEventType::DISPATCH, coreId, pid, process->instructionPointer);
+        }
     }
 
-    int quantumRemaining = timeQuantum;
+    if (!process) {
+        replayer->abort();
+        queueCV.notify_all();
+        return nullptr;
+    }
+    replayer->advance();
+    return process;
+}
+
+void ProcessScheduler::executeProcess(std::shared_ptr<Process> process, int coreId) {
+    // Policy, quantum and delay are fixed for the whole dispatch; reload-config takes effect at the next one
+    SchedulerType policy = schedulerType.load();
+    int quantumRemaining = timeQuantum.load();
+    int delay = delayPerInstruction.load();
+    int missPenalty = tlbMissPenalty.load();
+    int faultPenalty = pageFaultPenalty.load();
+    const SoftwareTlb& tlb = MemoryManager::getInstance().getTlb(coreId);
+    Timeline& timeline = Timeline::getInstance();
+    int64_t runStart = timeline.now();
+    int executed = 0;
     bool shouldPreempt = false;
+    bool requeued = false;
+    std::string terminatedBy;
     process->log("Started execution on Core " + std::to_string(coreId));
 
     while (process->instructionPointer < static_cast<int>(process->instructions.size()) &&
-        !shouldPreempt && !shouldStop.load()) {
+        !shouldPreempt && !shouldStop.load() && !isRetired(coreId)) {
+        if (pauseRequested.load(std::memory_order_relaxed)) {
+            parkCore(coreId, process);
+            if (shouldStop.load()) break;
+        }
         try {
             auto instruction = process->instructions[process->instructionPointer];
+            uint64_t missesBefore = tlb.getMisses();
+            int faultsBefore = process->pageFaults.load();
+            uint64_t loggedBefore = process->logs.bytesLogged();
+            auto started = std::chrono::steady_clock::now();
+            int64_t sleepStart = instruction->opcode() == Opcode::SLEEP ? timeline.now() : -1;
             instruction->execute(process, coreId);
+            Profiler::getInstance().record(*process, coreId, instruction->opcode(),
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count(),
+                process->logs.bytesLogged() - loggedBefore);
             (*process->completedInstructions)++;
             process->instructionPointer++;
+            executed++;
+            coreStates[coreId].instructions.fetch_add(1, std::memory_order_relaxed);
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(delayPerInstruction));
+            // Each TLB miss in READ/WRITE stalls the core for a page-walk penalty, each page fault for a swap-in
+            int stall = missPenalty * static_cast<int>(tlb.getMisses() - missesBefore) +
+                faultPenalty * (process->pageFaults.load() - faultsBefore);
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay + stall));
+            if (sleepStart >= 0) {
+                timeline.record(coreId, TimelineKind::SLEEP, process->pid, sleepStart,
+                    static_cast<const SleepInstruction&>(*instruction).getDuration());
+            }
 
-            if (schedulerType == SchedulerType::ROUND_ROBIN && --quantumRemaining <= 0) {
+            if (policy == SchedulerType::ROUND_ROBIN && --quantumRemaining <= 0) {
                 shouldPreempt = true;
                 if (process->instructionPointer < static_cast<int>(process->instructions.size())) {
-                    process->setStatus(ProcessStatus::READY);
-                    {
-                        std::lock_guard<std::mutex> lock(queueMutex);
-                        readyQueue.push(process); // Preempted: requeue at tail
-                    }
-                    process->log("Preempted after quantum");
-                    queueCV.notify_one();
+                    process->preemptions++;
+                    coreStates[coreId].preemptions.fetch_add(1, std::memory_order_relaxed);
+                    requeueFromCore(process, coreId, "Preempted after quantum");
+                    requeued = true;
                 }
             }
         }
+        catch (const AccessViolation& e) {
+            terminatedBy = e.what();
+            break;
+        }
         catch (const std::exception& e) {
             process->log("Error executing instruction: " + std::string(e.what()));
             break;
         }
     }
 
-    if (process->instructionPointer >= static_cast<int>(process->instructions.size())) {
-        process->setStatus(ProcessStatus::DONE);
+    // Once requeued, another core may already be running (or finishing) the process
+    if (requeued) {
+        timeline.record(coreId, TimelineKind::RUN, process->pid, runStart, executed, "preempted");
+        return;
+    }
+
+    if (isRetired(coreId) && !shouldStop.load() &&
+        process->instructionPointer < static_cast<int>(process->instructions.size())) {
+        timeline.record(coreId, TimelineKind::RUN, process->pid, runStart, executed, "core removed");
+        requeueFromCore(process, coreId, "Core " + std::to_string(coreId) + " removed by reload-config");
+        return;
+    }
+
+    process->isRunning = false;
+    if (!terminatedBy.empty() || process->instructionPointer >= static_cast<int>(process->instructions.size())) {
+        // endTime and the termination reason must be written before DONE is published;
+        // reports read them once isFinished is set
+        timeline.record(coreId, TimelineKind::RUN, process->pid, runStart, executed,
+            terminatedBy.empty() ? "completed" : "terminated");
         process->endTime = getCurrentTimestamp();
-        process->log("Process completed successfully");
-        deallocateProcessMemory(process);
+        process->terminationReason = terminatedBy;
+        process->setStatus(ProcessStatus::DONE);
+        processesFinished.fetch_add(1, std::memory_order_relaxed);
+        process->completionTick = cpuTick.load();
+        LatencyStats::getInstance().recordCompletion(policy, process->waitingTicks,
+            process->firstDispatchTick - process->arrivalTick,
+            process->completionTick - process->arrivalTick, process->preemptions);
+        if (terminatedBy.empty()) process->log("Process completed successfully");
+        else process->log("Process terminated: " + terminatedBy + " (instruction " + std::to_string(process->instructionPointer + 1) + ")");
+        bool replayTurn = replayer && replayer->awaitTurn(TraceEventType::COMPLETE, coreId, process->pid);
+        TraceRecorder::getInstance().record(TraceEventType::COMPLETE, coreId, process->pid, process->completedInstructions->load());
+        if (replayTurn) replayer->advance();
+        deallocateProcessMemory(process, coreId);
         process->writeLogToFile();
+        ProcessManager::retire(process);
         /*std::cout << "Process " << process->name << " (PID: " << process->pid
             << ") completed on core " << coreId << "\n";*/
     }
+    else {
+        timeline.record(coreId, TimelineKind::RUN, process->pid, runStart, executed, "stopped");
+    }
 }
 
-void ProcessScheduler::deallocateProcessMemory(std::shared_ptr<Process> process) {
+// Puts a process that still has instructions left back at the tail of the ready queue
+void ProcessScheduler::requeueFromCore(std::shared_ptr<Process> process, int coreId, const std::string& reason) {
+    process->setStatus(ProcessStatus::READY);
+    process->readySinceTick = cpuTick.load();
+    process->log(reason);
+    process->isRunning = false;
+    // The worker returns it through its completion ring once executeProcess is done with it
+    if (centralDispatch) {
+        TraceRecorder::getInstance().record(TraceEventType::PREEMPT, coreId, process->pid, process->instructionPointer);
+        return;
+    }
+    bool replayTurn = replayer && replayer->awaitTurn(TraceEventType::PREEMPT, coreId, process->pid);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        readyQueue.push_back(process);
+        readyDepth = static_cast<int>(readyQueue.size());
+        TraceRecorder::getInstance().record(TraceEventType::PREEMPT, coreId, process->pid, process->instructionPointer);
+    }
+    if (replayTurn) replayer->advance();
+    queueCV.notify_one();
+}
+
+void ProcessScheduler::parkCore(int coreId, std::shared_ptr<Process> process) {
+    std::unique_lock<std::mutex> lock(pauseMutex);
+    parkedProcesses[coreId] = process;
+    parkedCores++;
+    pauseCV.notify_all();
+    pauseCV.wait(lock, [this] { return !pauseRequested.load() || shouldStop.load(); });
+    parkedCores--;
+    parkedProcesses[coreId] = nullptr;
+    pauseCV.notify_all();
+}
+
+bool ProcessScheduler::checkpoint(const std::string& filename, bool generating) {
+    if (!running.load() || gracefulStop) {
+        std::cout << "Scheduler is not running; nothing to checkpoint.\n";
+        return false;
+    }
+    if (replayer && !replayer->finished()) {
+        std::cout << "Cannot checkpoint while a trace replay is running.\n";
+        return false;
+    }
+
+    {
+        // Everything parked by the previous checkpoint must be running again first
+        std::unique_lock<std::mutex> lock(pauseMutex);
+        pauseCV.wait(lock, [this] { return (parkedCores == 0 && !dispatcherParked) || shouldStop.load(); });
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pauseRequested = true;
+    }
+    queueCV.notify_all();
+
+    const Config& config = Config::getInstance();
+    CheckpointState state;
+    state.generating = generating;
+    state.numCPU = numCPU;
+    state.roundRobin = schedulerType == SchedulerType::ROUND_ROBIN;
+    state.quantum = timeQuantum;
+    state.delay = delayPerInstruction;
+    state.minIns = config.minInstructions;
+    state.maxIns = config.maxInstructions;
+    state.memPerProc = config.memPerProc;
+    state.batchFreq = config.batchProcessFreq;
+    ProcessManager::getCounters(state.nextPid, state.nextUniqueName);
+
+    CheckpointWriter encoded;
+    bool captured = false;
+    {
+        std::unique_lock<std::mutex> lock(pauseMutex);
+        pauseCV.wait(lock, [this] {
+            return (parkedCores == numCPU && (!centralDispatch || dispatcherParked)) || shouldStop.load();
+            });
+        if (!shouldStop.load()) {
+            state.tick = cpuTick.load();
+            for (const auto& process : parkedProcesses) {
+                if (process) state.processes.push_back(process);
+            }
+            state.runningCount = state.processes.size();
+            {
+                std::lock_guard<std::mutex> queueLock(queueMutex);
+                state.processes.insert(state.processes.end(), readyQueue.begin(), readyQueue.end());
+            }
+            const MemoryManager& memory = MemoryManager::getInstance();
+            for (const auto& process : state.processes) state.regions.push_back(memory.readRegion(*process));
+            encoded = encodeCheckpoint(state);
+            captured = true;
+        }
+        pauseRequested = false;
+    }
+    pauseCV.notify_all();
+    queueCV.notify_all();
+
+    if (!captured) {
+        std::cout << "Scheduler stopped before the checkpoint was taken.\n";
+        return false;
+    }
+    if (!saveCheckpoint(filename, encoded)) {
+        std::cout << "Could not write checkpoint file: " << filename << "\n";
+        return false;
+    }
+    std::cout << "Checkpoint written to " << filename << ": " << state.processes.size() << " processes ("
+        << state.runningCount << " on cores), tick " << state.tick << ", " << encoded.bytes.size() << " bytes\n";
+    return true;
+}
+
+void ProcessScheduler::restoreProcess(std::shared_ptr<Process> process) {
+    if (!process) return;
+    process->setStatus(ProcessStatus::READY);
+    processesArrived.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(queueMutex);
+    readyQueue.push_back(process);
+    readyDepth = static_cast<int>(readyQueue.size());
+}
+
+void ProcessScheduler::deallocateProcessMemory(std::shared_ptr<Process> process, int coreId) {
     if (process->getBaseAddress() != -1) {
-        MemoryManager::getInstance().deallocate(process);
+        bool replayTurn = replayer && replayer->awaitTurn(TraceEventType::FREE, coreId, process->pid);
+        MemoryManager::getInstance().deallocate(process, coreId);
+        if (replayTurn) replayer->advance();
     }
 }
 
@@ -261,16 +835,442 @@ size_t ProcessScheduler::getReadyQueueSize() const {
     return readyQueue.size();
 }
 
+void ProcessScheduler::publishCore(int coreId, int pid, int tick) {
+    CoreState& slot = coreStates[coreId];
+    slot.seq.fetch_add(1, std::memory_order_acq_rel);
+    slot.pid.store(pid, std::memory_order_relaxed);
+    slot.dispatchTick.store(tick, std::memory_order_relaxed);
+    slot.seq.fetch_add(1, std::memory_order_release);
+}
+
+// Builds a report view without touching queueMutex or memLock, so the cores never
+// stall on it. Core slots are read through their seqlocks; every other process is
+// classified from its own atomic flags. A process still published on a core counts
+// as running even if it has just set its DONE flag, so no process appears twice.
+SystemSnapshot ProcessScheduler::takeSnapshot() const {
+    SystemSnapshot snapshot;
+    snapshot.tick = cpuTick.load();
+    snapshot.numCPU = coreStates ? numCPU.load() : 0;
+
+    std::vector<int> corePids(snapshot.numCPU, -1);
+    for (int i = 0; i < snapshot.numCPU; ++i) {
+        const CoreState& slot = coreStates[i];
+        uint32_t before, after;
+        int pid, tick;
+        do {
+            before = slot.seq.load(std::memory_order_acquire);
+            pid = slot.pid.load(std::memory_order_relaxed);
+            tick = slot.dispatchTick.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = slot.seq.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        corePids[i] = pid;
+        CoreSnapshot core;
+        core.coreId = i;
+        core.dispatchTick = tick;
+        core.busyTicks = slot.busyTicks.load(std::memory_order_relaxed);
+        core.idleTicks = slot.idleTicks.load(std::memory_order_relaxed);
+        core.dispatches = slot.dispatches.load(std::memory_order_relaxed);
+        core.utilization = slot.getUtilization();
+        snapshot.cores.push_back(core);
+    }
+
+    auto processes = ProcessManager::getAllProcesses();
+    std::unordered_map<int, std::shared_ptr<Process>> byPid;
+    byPid.reserve(processes.size());
+    for (const auto& p : processes) byPid[p->pid] = p;
+
+    std::unordered_map<int, int> pidToCore;
+    for (int i = 0; i < snapshot.numCPU; ++i) {
+        if (corePids[i] < 0) continue;
+        auto it = byPid.find(corePids[i]);
+        if (it == byPid.end()) continue;
+        snapshot.cores[i].process = it->second;
+        snapshot.running.push_back(it->second);
+        pidToCore[corePids[i]] = i;
+    }
+
+    for (const auto& p : processes) {
+        if (pidToCore.count(p->pid)) continue;
+        if (p->isFinished.load()) snapshot.finished.push_back(p);
+        else snapshot.waiting.push_back(p);
+    }
+    snapshot.archived = ProcessArchive::getInstance().getRecords();
+
+    uint64_t busy = 0, elapsed = 0;
+    for (const auto& core : snapshot.cores) {
+        busy += core.busyTicks;
+        elapsed += core.busyTicks + core.idleTicks;
+    }
+    snapshot.coresUsed = static_cast<int>(snapshot.running.size());
+    snapshot.cpuUtilization = elapsed > 0 ? (static_cast<double>(busy) / elapsed) * 100.0 : 0.0;
+    return snapshot;
+}
+
+double ProcessScheduler::getCpuUtilization() const {
+    int cores = coreStates ? numCPU.load() : 0;
+    uint64_t busy = 0, elapsed = 0;
+    for (int i = 0; i < cores; ++i) {
+        uint64_t coreBusy = coreStates[i].busyTicks.load(std::memory_order_relaxed);
+        busy += coreBusy;
+        elapsed += coreBusy + coreStates[i].idleTicks.load(std::memory_order_relaxed);
+    }
+    return elapsed > 0 ? (static_cast<double>(busy) / elapsed) * 100.0 : 0.0;
+}
+
+void ProcessScheduler::writeStatus(std::ostream& out, const SystemSnapshot& snapshot) const {
+    std::ios_base::fmtflags flags(out.flags());
+    std::streamsize precision = out.precision();
+
+    out << "CPU utilization: " << std::fixed << std::setprecision(0) << snapshot.cpuUtilization << "%\n";
+    out << "Cores used: " << snapshot.coresUsed << "\n";
+    out << "Cores available: " << (snapshot.numCPU - snapshot.coresUsed) << "\n";
+    for (const auto& core : snapshot.cores) {
+        out << "  Core " << core.coreId << ": " << std::setprecision(1) << core.utilization << "% busy ("
+            << core.busyTicks << "/" << (core.busyTicks + core.idleTicks) << " ticks, "
+            << core.dispatches << " dispatches)\n";
+    }
+    out << std::setprecision(0);
+    out << "-------------------------------------------\n\n";
+
+    out << "Running processes:\n";
+    for (const auto& core : snapshot.cores) {
+        if (!core.process) continue;
+        const auto& p = core.process;
+        out << p->name << " " << p->startTime << " Core: " << core.coreId << " "
+            << p->completedInstructions->load() << " / " << p->totalInstructions << "\n";
+    }
+
+    out << "\nFinished processes:\n";
+    for (const auto& p : snapshot.archived) {
+        out << p.name << " " << p.endTime << " Finished "
+            << p.completedInstructions << " / " << p.totalInstructions << "\n";
+    }
+    for (const auto& p : snapshot.finished) {
+        out << p->name << " " << p->endTime << " Finished "
+            << p->completedInstructions->load() << " / " << p->totalInstructions << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+uint64_t ProcessScheduler::totalInstructions() const {
+    if (!coreStates) return 0;
+    uint64_t total = 0;
+    for (int i = 0; i < numCPU; ++i) total += coreStates[i].instructions.load(std::memory_order_relaxed);
+    return total;
+}
+
+// Prometheus text exposition. Everything here is read from atomics, so a scrape
+// never contends with the cores on queueMutex or with allocations on memLock.
+void ProcessScheduler::writeMetrics(std::ostream& out) const {
+    int cores = coreStates ? numCPU.load() : 0;
+
+    out << "# HELP csopesy_ticks_total Scheduler ticks since the scheduler started.\n";
+    out << "# TYPE csopesy_ticks_total counter\n";
+    out << "csopesy_ticks_total " << cpuTick.load() << "\n";
+
+    out << "# HELP csopesy_ready_queue_depth Processes waiting in the ready queue.\n";
+    out << "# TYPE csopesy_ready_queue_depth gauge\n";
+    out << "csopesy_ready_queue_depth " << readyDepth.load() << "\n";
+
+    out << "# HELP csopesy_core_busy_ticks_total Ticks each core spent running a process.\n";
+    out << "# TYPE csopesy_core_busy_ticks_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_core_busy_ticks_total{core=\"" << i << "\"} " << coreStates[i].busyTicks.load() << "\n";
+    }
+
+    out << "# HELP csopesy_core_idle_ticks_total Ticks each core spent idle.\n";
+    out << "# TYPE csopesy_core_idle_ticks_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_core_idle_ticks_total{core=\"" << i << "\"} " << coreStates[i].idleTicks.load() << "\n";
+    }
+
+    out << "# HELP csopesy_instructions_total Instructions executed per core.\n";
+    out << "# TYPE csopesy_instructions_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_instructions_total{core=\"" << i << "\"} " << coreStates[i].instructions.load() << "\n";
+    }
+
+    out << "# HELP csopesy_instructions_per_second Instructions executed per second over the last second.\n";
+    out << "# TYPE csopesy_instructions_per_second gauge\n";
+    out << "csopesy_instructions_per_second " << instructionsPerSecond.load() << "\n";
+
+    out << "# HELP csopesy_context_switches_total Processes dispatched onto each core.\n";
+    out << "# TYPE csopesy_context_switches_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_context_switches_total{core=\"" << i << "\"} " << coreStates[i].dispatches.load() << "\n";
+    }
+
+    out << "# HELP csopesy_migrations_total Dispatches of a process that last ran on another core.\n";
+    out << "# TYPE csopesy_migrations_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_migrations_total{core=\"" << i << "\"} " << coreStates[i].migrations.load() << "\n";
+    }
+
+    const MemoryManager& memory = MemoryManager::getInstance();
+    out << "# HELP csopesy_tlb_hits_total READ/WRITE translations served by the core's TLB.\n";
+    out << "# TYPE csopesy_tlb_hits_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_tlb_hits_total{core=\"" << i << "\"} " << memory.getTlb(i).getHits() << "\n";
+    }
+    out << "# HELP csopesy_tlb_misses_total READ/WRITE translations that walked the process mapping.\n";
+    out << "# TYPE csopesy_tlb_misses_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_tlb_misses_total{core=\"" << i << "\"} " << memory.getTlb(i).getMisses() << "\n";
+    }
+    out << "# HELP csopesy_tlb_flushes_total TLB flushes on context switch.\n";
+    out << "# TYPE csopesy_tlb_flushes_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_tlb_flushes_total{core=\"" << i << "\"} " << memory.getTlb(i).getFlushes() << "\n";
+    }
+
+    out << "# HELP csopesy_preemptions_total Quantum expirations per core.\n";
+    out << "# TYPE csopesy_preemptions_total counter\n";
+    for (int i = 0; i < cores; ++i) {
+        out << "csopesy_preemptions_total{core=\"" << i << "\"} " << coreStates[i].preemptions.load() << "\n";
+    }
+
+    int runningCount = 0;
+    for (int i = 0; i < cores; ++i) {
+        if (!coreStates[i].isIdle()) runningCount++;
+    }
+    uint64_t arrived = processesArrived.load();
+    uint64_t finished = processesFinished.load();
+    uint64_t waitingCount = arrived - finished > static_cast<uint64_t>(runningCount)
+        ? arrived - finished - runningCount : 0;
+
+    out << "# HELP csopesy_processes Processes by state.\n";
+    out << "# TYPE csopesy_processes gauge\n";
+    out << "csopesy_processes{state=\"ready\"} " << waitingCount << "\n";
+    out << "csopesy_processes{state=\"running\"} " << runningCount << "\n";
+    out << "csopesy_processes{state=\"finished\"} " << finished << "\n";
+
+    out << "# HELP csopesy_arrivals_deferred_total Arrivals held back by admission control.\n";
+    out << "# TYPE csopesy_arrivals_deferred_total counter\n";
+    out << "csopesy_arrivals_deferred_total " << arrivalsDeferred.load() << "\n";
+    out << "# HELP csopesy_arrivals_rejected_total Arrivals dropped by admission control.\n";
+    out << "# TYPE csopesy_arrivals_rejected_total counter\n";
+    out << "csopesy_arrivals_rejected_total " << arrivalsRejected.load() << "\n";
+    out << "# HELP csopesy_admission_paused Whether process generation is paused by a watermark.\n";
+    out << "# TYPE csopesy_admission_paused gauge\n";
+    out << "csopesy_admission_paused " << (admissionPaused.load() ? 1 : 0) << "\n";
+
+    MemoryManager::getInstance().writeMetrics(out);
+    Profiler::getInstance().writeMetrics(out);
+    ProgramCache::getInstance().writeMetrics(out);
+}
+
+void ProcessScheduler::recordAdmission(uint64_t deferred, uint64_t rejected, bool paused) {
+    if (deferred) arrivalsDeferred.fetch_add(deferred, std::memory_order_relaxed);
+    if (rejected) arrivalsRejected.fetch_add(rejected, std::memory_order_relaxed);
+    if (admissionPaused.exchange(paused) != paused && paused) admissionPauses.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Machine-readable end-of-run summary for headless runs
+void ProcessScheduler::writeSummary(std::ostream& out) const {
+    const Config& config = Config::getInstance();
+    const MemoryManager& memory = MemoryManager::getInstance();
+    int cores = coreStates ? numCPU.load() : 0;
+    uint64_t instructions = totalInstructions();
+    double seconds = coreStates ? std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count() : 0.0;
+
+    int runningCount = 0;
+    for (int i = 0; i < cores; ++i) {
+        if (!coreStates[i].isIdle()) runningCount++;
+    }
+
+    std::ios_base::fmtflags flags(out.flags());
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(2);
+
+    out << "{\n";
+    out << "  \"config\": {\"num_cpu\": " << config.numCPU << ", \"scheduler\": " << jsonString(config.scheduler)
+        << ", \"quantum_cycles\": " << config.quantumCycles << ", \"batch_process_freq\": " << config.batchProcessFreq
+        << ", \"min_ins\": " << config.minInstructions << ", \"max_ins\": " << config.maxInstructions
+        << ", \"delay_per_exec\": " << config.delayPerInstruction << ", \"mem_per_proc\": " << config.memPerProc
+        << ", \"seed\": " << config.seed << ", \"dispatcher\": " << jsonString(centralDispatch ? "central" : "shared") << "},\n";
+    out << "  \"ticks\": " << cpuTick.load() << ",\n";
+    out << "  \"wall_seconds\": " << seconds << ",\n";
+    out << "  \"processes\": {\"arrived\": " << processesArrived.load() << ", \"finished\": " << processesFinished.load()
+        << ", \"running\": " << runningCount << ", \"ready\": " << readyDepth.load() << "},\n";
+    out << "  \"admission\": {\"deferred\": " << arrivalsDeferred.load() << ", \"rejected\": " << arrivalsRejected.load()
+        << ", \"pauses\": " << admissionPauses.load() << "},\n";
+    out << "  \"instructions\": " << instructions << ",\n";
+    out << "  \"instructions_per_second\": " << (seconds > 0 ? instructions / seconds : 0.0) << ",\n";
+    out << "  \"cpu_utilization\": " << getCpuUtilization() << ",\n";
+    uint64_t tlbHits, tlbMisses, tlbFlushes;
+    memory.getTlbTotals(tlbHits, tlbMisses, tlbFlushes);
+    out << "  \"tlb\": {\"hits\": " << tlbHits << ", \"misses\": " << tlbMisses << ", \"flushes\": " << tlbFlushes
+        << ", \"access_violations\": " << memory.getAccessViolations() << "},\n";
+
+    out << "  \"cores\": [";
+    for (int i = 0; i < cores; ++i) {
+        const CoreState& core = coreStates[i];
+        out << (i ? ",\n" : "\n") << "    {\"core\": " << i << ", \"busy_ticks\": " << core.busyTicks.load()
+            << ", \"idle_ticks\": " << core.idleTicks.load() << ", \"instructions\": " << core.instructions.load()
+            << ", \"dispatches\": " << core.dispatches.load() << ", \"preemptions\": " << core.preemptions.load()
+            << ", \"migrations\": " << core.migrations.load() << "}";
+    }
+    out << (cores ? "\n  ],\n" : "],\n");
+
+    out << "  \"memory\": {\"total_bytes\": " << memory.getTotalMemory() << ", \"used_bytes\": " << memory.getUsedMemory()
+        << ", \"committed_bytes\": " << memory.getCommittedBytes() << ", \"arenas\": " << memory.getArenaCount()
+        << ", \"arena_steals\": " << memory.getArenaSteals()
+        << ", \"allocations\": " << memory.getAllocations() << ", \"allocation_failures\": " << memory.getAllocationFailures() << "},\n";
+    out << "  \"paging\": {\"policy\": " << jsonString(memory.isPaging() ? config.pageReplacement : "none")
+        << ", \"faults\": " << memory.getPageFaults() << ", \"evictions\": " << memory.getPageEvictions()
+        << ", \"writebacks\": " << memory.getPageWritebacks() << "},\n";
+    const ProcessArchive& archive = ProcessArchive::getInstance();
+    out << "  \"archive\": {\"processes\": " << archive.getCount() << ", \"log_bytes\": " << archive.getRawBytes()
+        << ", \"compressed_bytes\": " << archive.getPackedBytes() << "},\n";
+    out << "  \"opcodes\": ";
+    Profiler::getInstance().writeJson(out);
+    out << ",\n";
+    out << "  \"latency_ticks\": ";
+    LatencyStats::getInstance().writeJson(out);
+    out << "\n}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
 void ProcessScheduler::generateReport() {
-    // No change from previous
+    SystemSnapshot snapshot = takeSnapshot();
+
+    std::ofstream report("csopesy-log.txt");
+    if (!report.is_open()) {
+        std::cout << "Could not write csopesy-log.txt\n";
+        return;
+    }
+
+    report << "CSOPESY Emulator Report\n\n";
+    writeStatus(report, snapshot);
+    report << "\n";
+    LatencyStats::getInstance().writeReport(report);
+    report.close();
+
+    std::cout << "Report generated at csopesy-log.txt\n";
 }
 
 void ProcessScheduler::printStatus() const {
-    // No change from previous
+    SystemSnapshot snapshot = takeSnapshot();
+    std::cout << "\n";
+    writeStatus(std::cout, snapshot);
 }
 
 // Global helper functions
-void startScheduler(const Config& config) { globalScheduler.start(config); }
+bool reconfigureScheduler(const Config& config) { return globalScheduler.reconfigure(config); }
+void startScheduler(const Config& config) {
+    globalScheduler.setReplayer(nullptr);
+    globalScheduler.setStartTick(0);
+    globalScheduler.start(config);
+}
 void stopScheduler() { globalScheduler.stop(); }
+void shutdownScheduler() { globalScheduler.shutdown(); }
+void setSchedulerQuiet(bool quiet) { globalScheduler.setQuiet(quiet); }
+bool isSchedulerRunning() { return globalScheduler.isRunning(); }
+int getReadyDepth() { return globalScheduler.getReadyDepth(); }
+uint64_t getProcessesInFlight() { return globalScheduler.getProcessesInFlight(); }
+void recordAdmission(uint64_t deferred, uint64_t rejected, bool paused) { globalScheduler.recordAdmission(deferred, rejected, paused); }
 void addProcess(std::shared_ptr<Process> p) { globalScheduler.addProcess(p); }
 void generateReport() { globalScheduler.generateReport(); }
+void printStatus() { globalScheduler.printStatus(); }
+SystemSnapshot takeSnapshot() { return globalScheduler.takeSnapshot(); }
+double getCpuUtilization() { return globalScheduler.getCpuUtilization(); }
+void writeMetrics(std::ostream& out) { globalScheduler.writeMetrics(out); }
+void writeSummary(std::ostream& out) { globalScheduler.writeSummary(out); }
+
+bool startReplay(const std::string& traceFile) {
+    if (globalScheduler.isRunning()) {
+        std::cout << "Stop the scheduler before replaying a trace.\n";
+        return false;
+    }
+
+    auto replayer = std::make_shared<TraceReplayer>();
+    if (!replayer->load(traceFile)) {
+        std::cout << "Could not read trace file: " << traceFile << "\n";
+        return false;
+    }
+
+    // Re-create the recorded run: same core count, policy and process generation parameters
+    Config& config = Config::getInstance();
+    const auto& header = replayer->getHeader();
+    config.numCPU = header.numCPU;
+    config.scheduler = header.roundRobin ? "rr" : "fcfs";
+    config.quantumCycles = header.quantum;
+    config.minInstructions = header.minIns;
+    config.maxInstructions = header.maxIns;
+    config.memPerProc = header.memPerProc;
+    config.delayPerInstruction = header.delay;
+
+    ProcessManager::clearAllProcesses();
+    MemoryManager::getInstance().reset();
+
+    globalScheduler.setReplayer(replayer);
+    globalScheduler.setStartTick(0);
+    globalScheduler.start(config);
+    std::cout << "Replaying " << replayer->getEventCount() << " trace events from " << traceFile << "\n";
+
+    std::thread([replayer]() { replayer->driveArrivals(); }).detach();
+    return true;
+}
+
+int getSchedulerStartTick() { return globalScheduler.getStartTick(); }
+bool writeCheckpoint(const std::string& filename, bool generating) { return globalScheduler.checkpoint(filename, generating); }
+
+bool restoreCheckpoint(const std::string& filename, bool& generating) {
+    if (globalScheduler.isRunning()) {
+        std::cout << "Stop the scheduler before restoring a checkpoint.\n";
+        return false;
+    }
+
+    auto began = std::chrono::steady_clock::now();
+    CheckpointState state;
+    if (!loadCheckpoint(filename, state)) {
+        std::cout << "Could not read checkpoint file: " << filename << "\n";
+        return false;
+    }
+
+    // The checkpointed run's core count, policy and generation parameters win over config.txt
+    Config& config = Config::getInstance();
+    config.numCPU = state.numCPU;
+    config.scheduler = state.roundRobin ? "rr" : "fcfs";
+    config.quantumCycles = state.quantum;
+    config.delayPerInstruction = state.delay;
+    config.minInstructions = state.minIns;
+    config.maxInstructions = state.maxIns;
+    config.memPerProc = state.memPerProc;
+    config.batchProcessFreq = state.batchFreq;
+
+    ProcessManager::clearAllProcesses();
+    ProcessManager::setCounters(state.nextPid, state.nextUniqueName);
+    MemoryManager& memory = MemoryManager::getInstance();
+    memory.reset();
+    memory.restoreLayout(state.processes);
+    memory.setCycle(state.tick);
+    for (size_t i = 0; i < state.processes.size() && i < state.regions.size(); ++i) {
+        memory.writeRegion(*state.processes[i], state.regions[i]);
+    }
+
+    for (size_t i = 0; i < state.processes.size(); ++i) {
+        const auto& process = state.processes[i];
+        // Time spent on a core before the checkpoint is not waiting time
+        if (i < state.runningCount) process->readySinceTick = state.tick;
+        ProcessManager::addProcess(process);
+        globalScheduler.restoreProcess(process);
+    }
+
+    globalScheduler.setReplayer(nullptr);
+    globalScheduler.setStartTick(state.tick);
+    globalScheduler.start(config);
+    generating = state.generating;
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - began).count();
+    std::cout << "Restored " << state.processes.size() << " processes at tick " << state.tick << " from "
+        << filename << " in " << std::fixed << std::setprecision(1) << ms << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+    return true;
+}
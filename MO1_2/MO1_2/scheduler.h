@@ -3,13 +3,89 @@
 
 #include "process.h"
 #include "config.h"
+#include "ProcessArchive.h"
+#include "Affinity.h"
+#include "SpscRing.h"
+#include <algorithm>
 #include <memory>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <thread>
+#include <chrono>
+
+class TraceReplayer;
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+// Ready-queue entries a core looks through for one not reserved by another core
+constexpr size_t AFFINITY_SCAN = 32;
+// Empty polls a core or the central dispatcher yields through before sleeping 1ms between polls
+constexpr int IDLE_SPINS = 64;
+
+// Per-core state block. Each block starts on its own cache line so cores never
+// false-share, and the fields written by the tick thread sit on a second line
+// so sampling does not bounce the line the owning core writes on every instruction.
+// pid/dispatchTick are published with a seqlock: the owning core is the only
+// writer, readers retry until they observe an even, unchanged sequence number.
+struct alignas(CACHE_LINE_SIZE) CoreState {
+    std::atomic<uint32_t> seq{ 0 };
+    std::atomic<int> pid{ -1 };
+    std::atomic<int> dispatchTick{ -1 };
+    std::atomic<uint64_t> instructions{ 0 };
+    std::atomic<uint64_t> dispatches{ 0 };
+    std::atomic<uint64_t> preemptions{ 0 };
+    std::atomic<uint64_t> migrations{ 0 };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> busyTicks{ 0 };
+    std::atomic<uint64_t> idleTicks{ 0 };
+
+    bool isIdle() const { return pid.load(std::memory_order_acquire) < 0; }
+    double getUtilization() const {
+        uint64_t busy = busyTicks.load(std::memory_order_relaxed);
+        uint64_t total = busy + idleTicks.load(std::memory_order_relaxed);
+        return total == 0 ? 0.0 : (static_cast<double>(busy) / total) * 100.0;
+    }
+};
+
+// A process handed back by a core under central dispatch: requeue is set when it still
+// has instructions left (preempted, memory not available, core removed)
+struct CoreCompletion {
+    std::shared_ptr<Process> process;
+    bool requeue = false;
+};
+
+// Central dispatch links for one core. The dispatcher is the only producer on the
+// mailbox and the only consumer of completions; the core is the other side of both.
+// The dispatcher keeps at most one process outstanding per core, so both rings stay small.
+struct alignas(CACHE_LINE_SIZE) CoreChannel {
+    SpscRing<std::shared_ptr<Process>, 4> mailbox;
+    SpscRing<CoreCompletion, 4> completions;
+    std::atomic<bool> released{ false };  // set by the dispatcher once a removed core may exit
+};
+
+struct CoreSnapshot {
+    int coreId = -1;
+    int dispatchTick = -1;
+    uint64_t busyTicks = 0;
+    uint64_t idleTicks = 0;
+    uint64_t dispatches = 0;
+    double utilization = 0.0;
+    std::shared_ptr<Process> process;
+};
+
+struct SystemSnapshot {
+    int tick = 0;
+    int numCPU = 0;
+    int coresUsed = 0;
+    double cpuUtilization = 0.0;  // busy ticks / elapsed ticks across all cores
+    std::vector<CoreSnapshot> cores;
+    std::vector<std::shared_ptr<Process>> running;
+    std::vector<std::shared_ptr<Process>> waiting;
+    std::vector<std::shared_ptr<Process>> finished;
+    std::vector<ArchivedProcess> archived;  // evicted finished processes, oldest first
+};
 
 enum class SchedulerType {
     FCFS,
@@ -18,7 +94,7 @@ enum class SchedulerType {
 
 class ProcessScheduler {
 private:
-    std::queue<std::shared_ptr<Process>> readyQueue;
+    std::deque<std::shared_ptr<Process>> readyQueue;
     mutable std::mutex queueMutex;
     std::condition_variable queueCV;
 
@@ -26,35 +102,116 @@ private:
     std::atomic<bool> shouldStop{ false };
     std::atomic<int> quantumCycle{ 0 };
 
-    std::vector<std::thread> workerThreads;
-    std::vector<bool> coreAvailable;
+    // Lock-free mirrors of scheduler state for metrics scrapes
+    std::atomic<int> readyDepth{ 0 };
+    std::atomic<uint64_t> processesArrived{ 0 };
+    std::atomic<uint64_t> processesFinished{ 0 };
+    std::atomic<uint64_t> instructionsPerSecond{ 0 };
+
+    // Admission control outcome, reported by the workload generator
+    std::atomic<uint64_t> arrivalsDeferred{ 0 };
+    std::atomic<uint64_t> arrivalsRejected{ 0 };
+    std::atomic<uint64_t> admissionPauses{ 0 };
+    std::atomic<bool> admissionPaused{ false };
 
-    SchedulerType schedulerType = SchedulerType::ROUND_ROBIN;
-    int timeQuantum = 3;
-    int delayPerInstruction = 100;
-    int numCPU = 4;
+    std::vector<std::thread> workerThreads;  // indexed by core id, sized to coreCapacity
+    std::thread tickThread;
+    std::unique_ptr<CoreState[]> coreStates;
+
+    // Central dispatch (dispatcher central); fixed for the lifetime of a run
+    bool centralDispatch = false;
+    std::thread dispatcherThread;
+    std::unique_ptr<CoreChannel[]> channels;
+    std::atomic<int> inFlight{ 0 };               // processes in mailboxes, on cores or in completion rings
+    std::atomic<bool> dispatchHeld{ false };      // dispatcher stopped placing work for a checkpoint
+    std::atomic<uint64_t> dispatcherPasses{ 0 };
+    bool dispatcherParked = false;                // guarded by pauseMutex
+    int coreCapacity = 0;
+
+    // reload-config may change these while the cores run; each dispatch reads them once
+    std::atomic<SchedulerType> schedulerType{ SchedulerType::ROUND_ROBIN };
+    std::atomic<int> timeQuantum{ 3 };
+    std::atomic<int> delayPerInstruction{ 100 };
+    std::atomic<int> tlbMissPenalty{ 0 };  // extra ms a core stalls per TLB miss
+    std::atomic<int> pageFaultPenalty{ 0 };  // extra ms a core stalls per page fault
+    std::atomic<int> affinityWindow{ 0 };  // ticks a ready process stays reserved for its last core
+    // Active cores; workers with coreId >= numCPU drain their process and exit
+    std::atomic<int> numCPU{ 4 };
     bool gracefulStop = false;
+    bool quiet = false;
+    std::shared_ptr<TraceReplayer> replayer;
+    std::chrono::steady_clock::time_point startedAt;
+    int startTick = 0;  // clock value start() resumes from (non-zero after a restore)
+    AffinityPlan affinity;
+
+    // Checkpoint quiescence: cores park at an instruction boundary while state is captured
+    std::atomic<bool> pauseRequested{ false };
+    std::mutex pauseMutex;
+    std::condition_variable pauseCV;
+    int parkedCores = 0;
+    std::vector<std::shared_ptr<Process>> parkedProcesses;  // per core, null if it parked idle
 
     void schedulerLoop();
     void cpuWorker(int coreId);
-    bool tryAllocateMemory(std::shared_ptr<Process> process);
+    void dispatcherLoop();
+    bool drainCompletions(std::vector<char>& busy);
+    void holdDispatch(std::vector<char>& busy);
+    void waitForDispatcherPass();
+    std::shared_ptr<Process> receive(int coreId);
+    void complete(int coreId, std::shared_ptr<Process> process);
+    bool tryAllocateMemory(std::shared_ptr<Process> process, int coreId);
+    std::shared_ptr<Process> takeReplayDispatch(int coreId);
     void executeProcess(std::shared_ptr<Process> process, int coreId);
-    void deallocateProcessMemory(std::shared_ptr<Process> process);
+    void deallocateProcessMemory(std::shared_ptr<Process> process, int coreId);
+    void publishCore(int coreId, int pid, int tick);
+    void parkCore(int coreId, std::shared_ptr<Process> process);
+    std::deque<std::shared_ptr<Process>>::iterator pickFor(int coreId);
+    void requeueFromCore(std::shared_ptr<Process> process, int coreId, const std::string& reason);
+    bool isRetired(int coreId) const { return coreId >= numCPU.load(std::memory_order_relaxed); }
+    void applyAffinity(const Config& config);
+    void writeStatus(std::ostream& out, const SystemSnapshot& snapshot) const;
 
 public:
     ProcessScheduler() = default;
     ~ProcessScheduler();
 
     void start(const Config& config);
+    // Applies core count, quantum, delay and policy from config to the running scheduler
+    // Returns false when nothing was applied (stopping, or a replay is running)
+    bool reconfigure(const Config& config);
     void stop();
+    // Stops immediately and joins every worker before returning; running processes stay unfinished
+    void shutdown();
     void addProcess(std::shared_ptr<Process> process);
+    // Blocks until a process is ready; returns null once the scheduler is stopping
+    std::shared_ptr<Process> takeNext(int coreId);
+    void setReplayer(std::shared_ptr<TraceReplayer> trace) { replayer = trace; }
+    void setQuiet(bool value) { quiet = value; }
+    // Core count takeNext serves before start(); used by benchmarks that drive the queue directly
+    void setCoreCount(int cores) { if (!running.load()) numCPU = std::min(std::max(cores, 1), MAX_CORES); }
+    void setStartTick(int tick) { startTick = tick; }
+    int getStartTick() const { return startTick; }
+
+    // Parks every core, encodes the on-core processes and ready queue, resumes, then writes the file
+    bool checkpoint(const std::string& filename, bool generating);
+    // Queues a process restored from a checkpoint without resetting its arrival bookkeeping
+    void restoreProcess(std::shared_ptr<Process> process);
 
     bool isRunning() const { return running.load(); }
     int getCurrentCycle() const { return quantumCycle.load(); }
     size_t getReadyQueueSize() const;
+    uint64_t getProcessesFinished() const { return processesFinished.load(); }
+    uint64_t getProcessesInFlight() const { return processesArrived.load() - processesFinished.load(); }
+    int getReadyDepth() const { return readyDepth.load(); }
+    void recordAdmission(uint64_t deferred, uint64_t rejected, bool paused);
+    uint64_t totalInstructions() const;
 
+    SystemSnapshot takeSnapshot() const;
+    double getCpuUtilization() const;
     void generateReport();
     void printStatus() const;
+    void writeMetrics(std::ostream& out) const;
+    void writeSummary(std::ostream& out) const;
 };
 
 // Global variables used externally
@@ -62,13 +219,30 @@ extern std::vector<std::shared_ptr<Process>> allProcesses;
 extern bool stop;
 extern bool running;
 extern SchedulerType schedulerType;
-extern int cpuTick;
+extern std::atomic<int> cpuTick;
 extern int timeQuantum;
 
 // Global helper functions (exposed to CLIManager or main.cpp)
 void startScheduler(const Config& config);
 void stopScheduler();
+void shutdownScheduler();
+void setSchedulerQuiet(bool quiet);
+bool isSchedulerRunning();
+int getReadyDepth();
+uint64_t getProcessesInFlight();
+void recordAdmission(uint64_t deferred, uint64_t rejected, bool paused);
 void addProcess(std::shared_ptr<Process> p);
 void generateReport();
+void printStatus();
+SystemSnapshot takeSnapshot();
+double getCpuUtilization();
+void writeMetrics(std::ostream& out);
+void writeSummary(std::ostream& out);
+bool startReplay(const std::string& traceFile);
+bool reconfigureScheduler(const Config& config);
+int getSchedulerStartTick();
+bool writeCheckpoint(const std::string& filename, bool generating);
+// Rebuilds processes, memory layout and clock from a checkpoint and starts the scheduler
+bool restoreCheckpoint(const std::string& filename, bool& generating);
 
 #endif // SCHEDULER_H
@@ -5,10 +5,18 @@
 #include <fstream>
 #include <sys/stat.h>
 
-std::string getCurrentTimestamp() {
-    std::time_t now = std::time(nullptr);
+std::tm toLocalTime(std::time_t time) {
     std::tm ltm;
-    localtime_s(&ltm, &now);  // Safe Windows version
+#ifdef _WIN32
+    localtime_s(&ltm, &time);  // Safe Windows version
+#else
+    localtime_r(&time, &ltm);
+#endif
+    return ltm;
+}
+
+std::string getCurrentTimestamp() {
+    std::tm ltm = toLocalTime(std::time(nullptr));
     std::stringstream ss;
     ss << std::put_time(&ltm, "(%m/%d/%Y %I:%M:%S%p)");
     return ss.str();
@@ -32,3 +40,12 @@ void logToFile(const std::string& processName, const std::string& message, int c
     if (coreId >= 0) out << " Core:" << coreId;
     out << " \"" << message << "\"" << std::endl;
 }
+
+std::string jsonString(const std::string& value) {
+    std::string quoted = "\"";
+    for (char ch : value) {
+        if (ch == '"' || ch == '\\') quoted += '\\';
+        quoted += ch;
+    }
+    return quoted + "\"";
+}
@@ -2,10 +2,14 @@
 #define UTILS_H
 
 #include <string>
+#include <ctime>
 
 // Declaration only
 std::string getCurrentTimestamp();
+std::tm toLocalTime(std::time_t time);
 bool fileExists(const std::string& filename);
 void logToFile(const std::string& processName, const std::string& message, int coreId = -1);
+// Quotes a string for JSON output, escaping quotes and backslashes
+std::string jsonString(const std::string& value);
 
 #endif